@@ -0,0 +1,80 @@
+// delta_stepping over a sweep of delta values against dijkstra on R-MAT, grid and G(n, m) inputs
+// usage: SSSP_bench [R-MAT scale = 20] [grid side = 1024] [threads = hardware concurrency]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "../graph/SSSP.h"
+#include "../graph/generators.h"
+
+template <typename F>
+double seconds(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename V, typename W>
+bool run(const std::string &name, const graph::CSR_graph<V, W> &g, size_t source, size_t threads) {
+    std::printf("%s: %zu vertices, %zu edges\n", name.c_str(), g.number_of_verteces(), g.get_targets().size());
+
+    std::vector<graph::distance_type<W>> expected;
+    auto baseline = seconds([&] { expected = graph::dijkstra(g, source); });
+    std::printf("  dijkstra                  %8.3f s\n", baseline);
+
+    auto tuned = graph::tune_delta(g);
+    for (graph::distance_type<W> delta : {tuned, decltype(tuned)(1), decltype(tuned)(8), decltype(tuned)(32),
+                                          decltype(tuned)(128), decltype(tuned)(512), decltype(tuned)(4096)}) {
+        std::vector<graph::distance_type<W>> distances;
+        auto time = seconds([&] { distances = graph::delta_stepping(g, source, delta, threads); });
+        if (distances != expected) {
+            std::fprintf(stderr, "%s: delta_stepping with delta %g disagrees with dijkstra\n", name.c_str(),
+                         static_cast<double>(delta));
+            return false;
+        }
+
+        std::printf("  delta_stepping delta %-5g%s %8.3f s (%.2fx dijkstra)\n", static_cast<double>(delta),
+                    delta == tuned ? "*" : " ", time, baseline / time);
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv) {
+    size_t scale = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20;
+    size_t side = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1024;
+    size_t threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : graph::default_threads();
+    constexpr size_t max_weight = 255;
+
+    std::printf("threads %zu, weights 1..%zu, * marks the tuned delta\n", threads, max_weight);
+
+    auto rmat = graph::random_rmat_graph<uint32_t, uint32_t>(scale, size_t(16) << scale, true, 1, 0.57, 0.19, 0.19,
+                                                             max_weight, threads);
+    if (!run("R-MAT", rmat, 0, threads))
+        return 1;
+
+    graph::CSR_builder<uint32_t, uint32_t> grid(side * side, false, true);
+    std::mt19937_64 gen(2);
+    std::uniform_int_distribution<uint32_t> weight_dis(1, max_weight);
+    for (size_t i = 0; i < side; ++i) {
+        for (size_t j = 0; j < side; ++j) {
+            if (j + 1 < side)
+                grid.add_edge(i * side + j, i * side + j + 1, weight_dis(gen));
+            if (i + 1 < side)
+                grid.add_edge(i * side + j, (i + 1) * side + j, weight_dis(gen));
+        }
+    }
+    if (!run("grid", grid.build(), 0, threads))
+        return 1;
+
+    auto vertices = size_t(1) << (scale > 2 ? scale - 2 : 0);
+    auto gnm = graph::generate_random_directed_graph<graph::Node>(vertices, vertices * 8, max_weight);
+    if (!run("generate_random_directed_graph", graph::freeze<uint32_t, uint32_t>(gnm), 0, threads))
+        return 1;
+
+    return 0;
+}
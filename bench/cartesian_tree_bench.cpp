@@ -0,0 +1,54 @@
+// find_batch against a loop of single find calls on a tree larger than the last level cache
+// usage: cartesian_tree_bench [keys = 2^24] [lookups = 2^23]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../cartesian_tree/cartesian_tree.h"
+
+int main(int argc, char **argv) {
+    size_t keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t(1) << 24;
+    size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : size_t(1) << 23;
+
+    std::mt19937_64 gen(42);
+    Cartesian_tree<uint64_t, uint64_t> tree;
+    for (size_t i = 0; i < keys; ++i)
+        tree.append({i * 2, gen()});
+
+    std::vector<uint64_t> probes(lookups);
+    for (auto &it : probes)
+        it = gen() % (keys * 2);        // about half of the probes miss
+
+    auto seconds = [](std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto it : probes)
+        found += tree.find(it) != tree.end();
+    auto single = seconds(start);
+
+    std::vector<Cartesian_tree<uint64_t, uint64_t>::iterator> out(lookups);
+    start = std::chrono::steady_clock::now();
+    tree.find_batch(probes.begin(), probes.end(), out.begin());
+    auto batch = seconds(start);
+
+    size_t found_batch = 0;
+    for (const auto &it : out)
+        found_batch += it != tree.end();
+    if (found != found_batch) {
+        std::fprintf(stderr, "find_batch disagrees with find\n");
+        return 1;
+    }
+
+    std::printf("keys %zu, lookups %zu, hits %zu\n", keys, lookups, found);
+    std::printf("find       %8.2f Mlookups/s\n", lookups / single / 1e6);
+    std::printf("find_batch %8.2f Mlookups/s (%.2fx)\n", lookups / batch / 1e6, single / batch);
+
+    return 0;
+}
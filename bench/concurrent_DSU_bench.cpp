@@ -0,0 +1,94 @@
+// Concurrent_DSU unions over 1..max threads against Flat_DSU, both alone and shared behind a mutex;
+// edges come from graph::UndirectedGraph::generate_random_graph
+// usage: concurrent_DSU_bench [vertices = 2^20] [edges = 2^22] [max threads = hardware concurrency]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../disjoint_set_union/concurrent_DSU.h"
+#include "../disjoint_set_union/flat_DSU.h"
+#include "../graph/graph.h"
+#include "../graph/parallel.h"
+
+template <typename F>
+double run_threads(size_t threads, size_t count, F f) {        // f(lo, hi) over a static split of [0, count)
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (size_t i = 0; i < threads; ++i)
+        pool.emplace_back(f, count * i / threads, count * (i + 1) / threads);
+    for (auto &it : pool)
+        it.join();
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv) {
+    size_t vertices = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t(1) << 20;
+    size_t edges = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : size_t(1) << 22;
+    size_t max_threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : graph::default_threads();
+
+    graph::UndirectedGraph<size_t> g;
+    g.generate_random_graph(vertices, edges);
+
+    std::vector<std::pair<uint32_t, uint32_t>> list;
+    list.reserve(edges);
+    for (size_t i = 0; i < vertices; ++i)
+        for (auto it : g.adjacent(i))
+            if (i < it)
+                list.emplace_back(static_cast<uint32_t>(i), static_cast<uint32_t>(it));
+    std::shuffle(list.begin(), list.end(), std::mt19937_64(42));        // adjacency order would favour the caches
+
+    auto components = [vertices](auto &&find) {
+        size_t result = 0;
+        for (size_t i = 0; i < vertices; ++i)
+            result += find(static_cast<uint32_t>(i)) == i;
+        return result;
+    };
+
+    Flat_DSU<> serial(vertices);
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &it : list)
+        serial.unite(it.first, it.second);
+    auto serial_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    auto expected = components([&serial](uint32_t element) { return serial.find(element); });
+
+    std::printf("vertices %zu, edges %zu, components %zu\n", vertices, list.size(), expected);
+    std::printf("Flat_DSU serial          %8.2f Munions/s\n", list.size() / serial_time / 1e6);
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        Flat_DSU<> locked(vertices);
+        std::mutex lock;
+        auto locked_time = run_threads(threads, list.size(), [&](size_t lo, size_t hi) {
+            for (auto i = lo; i < hi; ++i) {
+                std::lock_guard<std::mutex> guard(lock);
+                locked.unite(list[i].first, list[i].second);
+            }
+        });
+
+        Concurrent_DSU concurrent(vertices);
+        auto concurrent_time = run_threads(threads, list.size(), [&](size_t lo, size_t hi) {
+            for (auto i = lo; i < hi; ++i)
+                concurrent.unite(list[i].first, list[i].second);
+        });
+
+        if (components([&concurrent](uint32_t element) { return concurrent.find(element); }) != expected ||
+            components([&locked](uint32_t element) { return locked.find(element); }) != expected) {
+            std::fprintf(stderr, "component count mismatch\n");
+            return 1;
+        }
+
+        std::printf("%2zu threads: locked Flat_DSU %8.2f Munions/s, Concurrent_DSU %8.2f Munions/s (%.2fx serial)\n",
+                    threads, list.size() / locked_time / 1e6, list.size() / concurrent_time / 1e6,
+                    serial_time / concurrent_time);
+    }
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+// BFS and SSSP time before and after degree, RCM and Gorder relabelling. Inputs start from randomly scrambled
+// ids, as produced by generators or callers that number vertices arbitrarily
+// usage: reorder_bench [R-MAT scale = 18] [grid side = 512] [threads = hardware concurrency]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../graph/BFS.h"
+#include "../graph/SSSP.h"
+#include "../graph/generators.h"
+#include "../graph/reorder.h"
+
+using Graph = graph::CSR_graph<uint32_t, uint32_t>;
+
+template <typename F>
+double seconds(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Timings {
+    double bfs;
+    double sssp;
+};
+
+// runs both traversals from every source; new_of_old maps the sources and checks levels and distances
+Timings traverse(const Graph &g, const std::vector<size_t> &sources, const std::vector<size_t> &new_of_old,
+                 const std::vector<std::vector<size_t>> &levels, const std::vector<std::vector<uint64_t>> &distances,
+                 size_t threads) {
+    Timings result{0, 0};
+    for (size_t i = 0, end_ = sources.size(); i < end_; ++i) {
+        auto source = new_of_old[sources[i]];
+
+        graph::BFS_result bfs;
+        result.bfs += seconds([&] { bfs = graph::bfs(g, source, threads); });
+        std::vector<uint64_t> sssp;
+        result.sssp += seconds([&] { sssp = graph::dijkstra(g, source); });
+
+        for (size_t v = 0, n = g.number_of_verteces(); v < n; ++v) {
+            if (bfs.levels[new_of_old[v]] != levels[i][v] || sssp[new_of_old[v]] != distances[i][v]) {
+                std::fprintf(stderr, "traversal differs after reordering\n");
+                std::exit(1);
+            }
+        }
+    }
+
+    return result;
+}
+
+void run(const std::string &name, const Graph &scrambled, size_t threads) {
+    size_t n = scrambled.number_of_verteces();
+    std::printf("%s: %zu vertices, %zu edges\n", name.c_str(), n, scrambled.get_targets().size());
+
+    std::mt19937_64 gen(7);
+    std::vector<size_t> sources;
+    while (sources.size() < 4) {
+        auto vertex = static_cast<size_t>(gen() % n);
+        if (scrambled.degree(vertex))
+            sources.push_back(vertex);
+    }
+
+    std::vector<size_t> identity(n);
+    std::iota(identity.begin(), identity.end(), 0);
+    std::vector<std::vector<size_t>> levels;
+    std::vector<std::vector<uint64_t>> distances;
+    for (auto source : sources) {
+        levels.push_back(graph::bfs(scrambled, source, threads).levels);
+        distances.push_back(graph::dijkstra(scrambled, source));
+    }
+
+    auto base = traverse(scrambled, sources, identity, levels, distances, threads);
+    std::printf("  %-9s reorder       -     BFS %7.3f s          dijkstra %7.3f s\n", "scrambled", base.bfs, base.sssp);
+
+    const std::pair<const char *, graph::Reorder_strategy> strategies[] = {
+            {"degree", graph::Reorder_strategy::degree},
+            {"rcm", graph::Reorder_strategy::rcm},
+            {"gorder", graph::Reorder_strategy::gorder}
+    };
+    for (const auto &it : strategies) {
+        graph::Reordered_graph<Graph> reordered;
+        auto time = seconds([&] { reordered = graph::reorder(scrambled, it.second, threads); });
+        auto timings = traverse(reordered.graph, sources, reordered.new_of_old, levels, distances, threads);
+        std::printf("  %-9s reorder %7.3f s   BFS %7.3f s (%.2fx)   dijkstra %7.3f s (%.2fx)\n", it.first, time,
+                    timings.bfs, base.bfs / timings.bfs, timings.sssp, base.sssp / timings.sssp);
+    }
+}
+
+Graph scramble(const Graph &g, uint64_t seed) {
+    std::vector<size_t> old_of_new(g.number_of_verteces());
+    std::iota(old_of_new.begin(), old_of_new.end(), 0);
+    std::shuffle(old_of_new.begin(), old_of_new.end(), std::mt19937_64(seed));
+
+    return graph::permute(g, old_of_new);
+}
+
+int main(int argc, char **argv) {
+    size_t scale = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 18;
+    size_t side = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 512;
+    size_t threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : graph::default_threads();
+    constexpr size_t max_weight = 255;
+
+    std::printf("threads %zu, 4 sources per graph, times are totals over the sources\n", threads);
+
+    run("R-MAT", scramble(graph::random_rmat_graph<uint32_t, uint32_t>(scale, size_t(16) << scale, false, 1, 0.57, 0.19,
+                                                                        0.19, max_weight, threads), 3), threads);
+
+    graph::CSR_builder<uint32_t, uint32_t> grid(side * side, false, true);
+    std::mt19937_64 gen(2);
+    std::uniform_int_distribution<uint32_t> weight_dis(1, max_weight);
+    for (size_t i = 0; i < side; ++i) {
+        for (size_t j = 0; j < side; ++j) {
+            if (j + 1 < side)
+                grid.add_edge(i * side + j, i * side + j + 1, weight_dis(gen));
+            if (i + 1 < side)
+                grid.add_edge(i * side + j, (i + 1) * side + j, weight_dis(gen));
+        }
+    }
+    run("grid", scramble(grid.build(), 4), threads);
+
+    return 0;
+}
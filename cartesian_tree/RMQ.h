@@ -0,0 +1,117 @@
+#pragma once
+
+#ifndef CARTESIANTREE_RMQ_H
+#define CARTESIANTREE_RMQ_H
+
+#endif //CARTESIANTREE_RMQ_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+inline size_t lowest_bit(uint64_t mask) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(mask);
+#else
+    size_t result = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++result;
+    }
+
+    return result;
+#endif
+}
+
+inline size_t highest_bit(uint64_t mask) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(mask);
+#else
+    size_t result = 0;
+    while (mask >>= 1)
+        ++result;
+
+    return result;
+#endif
+}
+
+template <typename T, typename Compare = std::less<T>>
+class RMQ final {       // the array is referenced, not copied, and must outlive the structure
+    static constexpr size_t block_size = 64;
+
+    const T *data;
+    size_t sz;
+    Compare cmp;
+    std::vector<uint64_t> masks;
+    std::vector<size_t> sparse;
+    size_t blocks;
+
+    size_t better(size_t lhs, size_t rhs) const {       // lhs < rhs, ties go to the leftmost position
+        return cmp(data[rhs], data[lhs]) ? rhs : lhs;
+    };
+    size_t in_block(size_t lo, size_t hi) const {
+        return hi - hi % block_size + lowest_bit(masks[hi] & (~uint64_t(0) << (lo % block_size)));
+    };
+
+public:
+    RMQ(const T *new_data_, size_t new_sz_, const Compare& new_cmp_ = Compare());
+    [[nodiscard]] size_t size() const {
+        return sz;
+    };
+    size_t query(size_t lo, size_t hi) const;
+};
+
+template <typename T, typename Compare>
+RMQ<T, Compare>::RMQ(const T *new_data_, size_t new_sz_, const Compare& new_cmp_) : data(new_data_), sz(new_sz_), cmp(new_cmp_), masks(new_sz_),
+                                                                                     blocks((new_sz_ + block_size - 1) / block_size) {
+    if (!data && sz)
+        throw std::invalid_argument("array");
+
+    // every mask holds the right spine of the in-block Cartesian tree, built with the stack of build_cartesian_tree
+    for (size_t start = 0; start < sz; start += block_size) {
+        uint64_t spine = 0;
+        for (size_t i = start, end_ = std::min(start + block_size, sz); i < end_; ++i) {
+            while (spine && cmp(data[i], data[start + highest_bit(spine)]))
+                spine &= ~(uint64_t(1) << highest_bit(spine));
+
+            spine |= uint64_t(1) << (i - start);
+            masks[i] = spine;
+        }
+    }
+
+    if (!blocks)
+        return;
+
+    size_t levels = highest_bit(blocks) + 1;
+    sparse.resize(levels * blocks);
+    for (size_t i = 0; i < blocks; ++i)
+        sparse[i] = in_block(i * block_size, std::min((i + 1) * block_size, sz) - 1);
+
+    for (size_t j = 1; j < levels; ++j) {
+        size_t half = size_t(1) << (j - 1);
+        for (size_t i = 0; i + 2 * half <= blocks; ++i)
+            sparse[j * blocks + i] = better(sparse[(j - 1) * blocks + i], sparse[(j - 1) * blocks + i + half]);
+    }
+}
+
+template <typename T, typename Compare>
+size_t RMQ<T, Compare>::query(size_t lo, size_t hi) const {        // index of the minimum on [lo, hi]
+    if (lo > hi || hi >= sz)
+        throw std::invalid_argument("range");
+
+    size_t lo_block = lo / block_size;
+    size_t hi_block = hi / block_size;
+    if (lo_block == hi_block)
+        return in_block(lo, hi);
+
+    size_t result = in_block(lo, lo_block * block_size + block_size - 1);
+    if (lo_block + 1 < hi_block) {
+        size_t level = highest_bit(hi_block - lo_block - 1);
+        result = better(result, better(sparse[level * blocks + lo_block + 1],
+                                       sparse[level * blocks + hi_block - (size_t(1) << level)]));
+    }
+
+    return better(result, in_block(hi_block * block_size, hi));
+}
@@ -8,9 +8,13 @@
 
 #endif //CARTESIANTREE_CARTESIAN_TREE_H
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <stdexcept>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 template <typename K, typename P>
 struct Node {
@@ -79,7 +83,7 @@ void pre_order_copy(Node<K, P> *goal, Node<K, P> *copy) {
     }
     if (copy->right) {
         goal->right = new Node<K, P>(*copy->right);
-        goal->right->predecessor = goal->right;
+        goal->right->predecessor = goal;
         pre_order_copy(goal->right, copy->right);
     }
 }
@@ -99,9 +103,9 @@ Node<K, P> *merge(Node<K, P> *lhs, Node<K, P> *rhs) {
             lhs->right->predecessor = lhs;
         return lhs;
     } else {
-        rhs->right = merge(rhs->right, lhs);
-        if (rhs->right)
-            rhs->right->predecessor = rhs;
+        rhs->left = merge(lhs, rhs->left);
+        if (rhs->left)
+            rhs->left->predecessor = rhs;
         return rhs;
     }
 }
@@ -133,8 +137,136 @@ std::tuple<Node<K, P> *, Node<K, P> *, Node<K, P> *> split(Node<K, P> *top, cons
     }
 }
 
+template <typename K, typename P>
+inline void prefetch(const Node<K, P> *node) {
+#if defined(__GNUC__)
+    __builtin_prefetch(node);
+#endif
+}
+
+template <typename K, typename P>
+Node<K, P> *leftmost(Node<K, P> *node) {
+    if (node)
+        while (node->left)
+            node = node->left;
+
+    return node;
+}
+
+template <typename K, typename P>
+Node<K, P> *rightmost(Node<K, P> *node) {
+    if (node)
+        while (node->right)
+            node = node->right;
+
+    return node;
+}
+
+template <typename K, typename P>
+Node<K, P> *next_node(Node<K, P> *node) {
+    if (node->right)
+        return leftmost(node->right);
+
+    while (node->predecessor && node == node->predecessor->right)
+        node = node->predecessor;
+
+    return node->predecessor;
+}
+
+template <typename K, typename P>
+Node<K, P> *prev_node(Node<K, P> *node) {
+    if (node->left)
+        return rightmost(node->left);
+
+    while (node->predecessor && node == node->predecessor->left)
+        node = node->predecessor;
+
+    return node->predecessor;
+}
+
+template <typename K, typename P>
+Node<K, P> *finger_climb(Node<K, P> *finger, const K& key) {     // returns the lowest ancestor whose subtree may hold key
+    auto node = finger;
+    if (node->key < key) {
+        while (node->predecessor && !(key < node->predecessor->key))
+            node = node->predecessor;
+    } else if (key < node->key) {
+        while (node->predecessor && !(node->predecessor->key < key))
+            node = node->predecessor;
+    }
+
+    return node;
+}
+
+template <typename K, typename P>
+Node<K, P> *descend(Node<K, P> *node, const K& key) {
+    while (node) {
+        if (key < node->key)
+            node = node->left;
+        else if (node->key < key)
+            node = node->right;
+        else
+            break;
+    }
+
+    return node;
+}
+
+template <typename K, typename P>
+struct Cartesian_tree;
+
+template <typename K, typename P>
+class Cartesian_tree_iterator final {
+    Node<K, P> *node;
+    const Cartesian_tree<K, P> *tree;
+
+    friend struct Cartesian_tree<K, P>;
+
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Node<K, P>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Node<K, P> *;
+    using reference = const Node<K, P>&;
+
+    Cartesian_tree_iterator() : node(nullptr), tree(nullptr) {};
+    Cartesian_tree_iterator(Node<K, P> *new_node_, const Cartesian_tree<K, P> *new_tree_) : node(new_node_), tree(new_tree_) {};
+    reference operator* () const {
+        return *node;
+    };
+    pointer operator-> () const {
+        return node;
+    };
+    Cartesian_tree_iterator& operator++ () {
+        node = next_node(node);
+        return *this;
+    };
+    Cartesian_tree_iterator operator++ (int) {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    };
+    Cartesian_tree_iterator& operator-- () {
+        node = node ? prev_node(node) : tree->maximum;
+        return *this;
+    };
+    Cartesian_tree_iterator operator-- (int) {
+        auto tmp = *this;
+        --*this;
+        return tmp;
+    };
+    bool operator== (const Cartesian_tree_iterator& other) const {
+        return node == other.node;
+    };
+    bool operator!= (const Cartesian_tree_iterator& other) const {
+        return node != other.node;
+    };
+};
+
 template <typename K, typename P>
 struct Cartesian_tree {
+    using iterator = Cartesian_tree_iterator<K, P>;
+
     Node<K, P> *top;
     Node<K, P> *maximum;
     size_t sz;
@@ -150,6 +282,7 @@ struct Cartesian_tree {
             sz = new_top_->get_weight();
 
             top = new_top_;
+            top->predecessor = nullptr;
 
             maximum = top;
             while (maximum->right)
@@ -237,6 +370,27 @@ struct Cartesian_tree {
     [[nodiscard]] size_t size() const {
         return sz;
     };
+    iterator begin() const {
+        return iterator(leftmost(top), this);
+    };
+    iterator end() const {
+        return iterator(nullptr, this);
+    };
+    iterator find(const K& key) const;
+    iterator find(iterator finger, const K& key) const;
+    template <typename INIt, typename OUTIt>
+    OUTIt find_batch(INIt first, INIt last, OUTIt out) const;
+    iterator lower_bound(const K& key) const;
+    iterator upper_bound(const K& key) const;
+    std::pair<iterator, iterator> range(const K& lo, const K& hi) const {     // [lo, hi)
+        return std::make_pair(lower_bound(lo), lower_bound(hi));
+    };
+    iterator erase(iterator position);
+    size_t erase(const K& key);
+    std::pair<iterator, bool> insert(iterator finger, const std::pair<K, P>& element);
+    std::pair<iterator, bool> append(const std::pair<K, P>& element) {
+        return insert(iterator(maximum, this), element);
+    };
     ~Cartesian_tree() {
         while (top)
         {
@@ -267,6 +421,396 @@ struct Cartesian_tree {
     };
 };
 
+template <typename K, typename P>
+typename Cartesian_tree<K, P>::iterator Cartesian_tree<K, P>::find(const K& key) const {
+    return iterator(descend(top, key), this);
+}
+
+template <typename K, typename P>
+typename Cartesian_tree<K, P>::iterator Cartesian_tree<K, P>::find(iterator finger, const K& key) const {
+    auto start = finger.node ? finger.node : maximum;
+    if (!start || maximum->key < key)
+        return end();
+
+    return iterator(descend(finger_climb(start, key), key), this);
+}
+
+template <typename K, typename P>
+template <typename INIt, typename OUTIt>
+OUTIt Cartesian_tree<K, P>::find_batch(INIt first, INIt last, OUTIt out) const {     // lookups of a group advance in lockstep
+    constexpr size_t group_size = 16;
+
+    K keys[group_size];
+    Node<K, P> *current[group_size];
+    bool done[group_size];
+
+    while (first != last) {
+        size_t sz = 0;
+        for (; sz < group_size && first != last; ++sz, ++first) {
+            keys[sz] = *first;
+            current[sz] = top;
+            done[sz] = false;
+        }
+
+        size_t active = sz;
+        while (active) {
+            for (size_t i = 0; i < sz; ++i) {
+                if (done[i])
+                    continue;
+
+                auto ptr = current[i];
+                if (!ptr || !(keys[i] < ptr->key || ptr->key < keys[i])) {
+                    done[i] = true;
+                    --active;
+                    continue;
+                }
+
+                ptr = keys[i] < ptr->key ? ptr->left : ptr->right;
+                if (ptr)
+                    prefetch(ptr);
+                current[i] = ptr;
+            }
+        }
+
+        for (size_t i = 0; i < sz; ++i, ++out)
+            *out = iterator(current[i], this);
+    }
+
+    return out;
+}
+
+template <typename K, typename P>
+typename Cartesian_tree<K, P>::iterator Cartesian_tree<K, P>::lower_bound(const K& key) const {
+    Node<K, P> *result = nullptr;
+    auto ptr = top;
+    while (ptr) {
+        if (ptr->key < key)
+            ptr = ptr->right;
+        else {
+            result = ptr;
+            ptr = ptr->left;
+        }
+    }
+
+    return iterator(result, this);
+}
+
+template <typename K, typename P>
+typename Cartesian_tree<K, P>::iterator Cartesian_tree<K, P>::upper_bound(const K& key) const {
+    Node<K, P> *result = nullptr;
+    auto ptr = top;
+    while (ptr) {
+        if (key < ptr->key) {
+            result = ptr;
+            ptr = ptr->left;
+        } else
+            ptr = ptr->right;
+    }
+
+    return iterator(result, this);
+}
+
+template <typename K, typename P>
+typename Cartesian_tree<K, P>::iterator Cartesian_tree<K, P>::erase(iterator position) {
+    auto node = position.node;
+    if (!node || position.tree != this)
+        throw std::invalid_argument("iterator");
+
+    auto following = next_node(node);
+
+    auto parent = node->predecessor;
+    auto replacement = merge(node->left, node->right);
+    if (replacement)
+        replacement->predecessor = parent;
+
+    if (!parent)
+        top = replacement;
+    else if (parent->left == node)
+        parent->left = replacement;
+    else
+        parent->right = replacement;
+
+    if (node == maximum)
+        maximum = replacement ? rightmost(replacement) : parent;
+
+    node->left = nullptr;
+    node->right = nullptr;
+    node->predecessor = nullptr;
+    delete node;
+    --sz;
+
+    return iterator(following, this);
+}
+
+template <typename K, typename P>
+size_t Cartesian_tree<K, P>::erase(const K& key) {
+    auto position = find(key);
+    if (position == end())
+        return 0;
+
+    erase(position);
+    return 1;
+}
+
+template <typename K, typename P>
+std::pair<typename Cartesian_tree<K, P>::iterator, bool> Cartesian_tree<K, P>::insert(iterator finger, const std::pair<K, P>& element) {
+    const auto& key = element.first;
+    const auto& priority = element.second;
+
+    Node<K, P> *parent = nullptr;
+    Node<K, P> *ptr = top;
+    bool appending = maximum && maximum->key < key;
+    if (appending) {
+        // the new node ends the right spine: climb from maximum past the spine nodes it displaces
+        parent = maximum;
+        while (parent && priority < parent->priority)
+            parent = parent->predecessor;
+        ptr = parent ? parent->right : top;
+    } else if (maximum) {
+        // lowest ancestor of the finger that covers key and whose parent does not outrank the new node
+        auto subtree = finger_climb(finger.node ? finger.node : maximum, key);
+        while (subtree->predecessor && priority < subtree->predecessor->priority)
+            subtree = subtree->predecessor;
+
+        parent = subtree->predecessor;
+        ptr = subtree;
+        while (ptr && !(priority < ptr->priority)) {
+            if (!(key < ptr->key || ptr->key < key))
+                return std::make_pair(iterator(ptr, this), false);
+            parent = ptr;
+            ptr = key < ptr->key ? ptr->left : ptr->right;
+        }
+
+        auto existing = descend(ptr, key);
+        if (existing)
+            return std::make_pair(iterator(existing, this), false);
+    }
+
+    auto new_node = new Node<K, P>(key, priority);
+
+    if (appending) {        // every displaced key is smaller, no split needed
+        new_node->left = ptr;
+    } else {
+        auto tmp_split = split(ptr, key);
+        new_node->left = std::get<0>(tmp_split);
+        new_node->right = std::get<2>(tmp_split);
+    }
+    if (new_node->left)
+        new_node->left->predecessor = new_node;
+    if (new_node->right)
+        new_node->right->predecessor = new_node;
+
+    new_node->predecessor = parent;
+    if (!parent)
+        top = new_node;
+    else if (key < parent->key)
+        parent->left = new_node;
+    else
+        parent->right = new_node;
+
+    if (!maximum || maximum->key < key)
+        maximum = new_node;
+    ++sz;
+
+    return std::make_pair(iterator(new_node, this), true);
+}
+
+template <typename K, typename P>
+struct Frozen_node {
+    K key;
+    P priority;
+};
+
+template <typename K, typename P>
+class Frozen_cartesian_tree;
+
+template <typename K, typename P>
+class Frozen_cartesian_tree_iterator final {
+    size_t index;       // position in the Eytzinger layout, 0 stands for end()
+    const Frozen_cartesian_tree<K, P> *tree;
+
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Frozen_node<K, P>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Frozen_node<K, P> *;
+    using reference = const Frozen_node<K, P>&;
+
+    Frozen_cartesian_tree_iterator() : index(0), tree(nullptr) {};
+    Frozen_cartesian_tree_iterator(size_t new_index_, const Frozen_cartesian_tree<K, P> *new_tree_) : index(new_index_), tree(new_tree_) {};
+    reference operator* () const {
+        return tree->nodes[index];
+    };
+    pointer operator-> () const {
+        return &tree->nodes[index];
+    };
+    Frozen_cartesian_tree_iterator& operator++ () {
+        index = tree->next_index(index);
+        return *this;
+    };
+    Frozen_cartesian_tree_iterator operator++ (int) {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    };
+    Frozen_cartesian_tree_iterator& operator-- () {
+        index = tree->prev_index(index);
+        return *this;
+    };
+    Frozen_cartesian_tree_iterator operator-- (int) {
+        auto tmp = *this;
+        --*this;
+        return tmp;
+    };
+    bool operator== (const Frozen_cartesian_tree_iterator& other) const {
+        return index == other.index;
+    };
+    bool operator!= (const Frozen_cartesian_tree_iterator& other) const {
+        return index != other.index;
+    };
+};
+
+template <typename K, typename P>
+class Frozen_cartesian_tree final {     // read-only snapshot, nodes are stored in Eytzinger (BFS) order starting from 1
+    std::vector<Frozen_node<K, P>> nodes;
+    size_t sz;
+
+    friend class Frozen_cartesian_tree_iterator<K, P>;
+
+    template <typename INIt>
+    void fill(size_t index, INIt& it) {
+        if (index > sz)
+            return;
+
+        fill(2 * index, it);
+        nodes[index].key = it->key;
+        nodes[index].priority = it->priority;
+        ++it;
+        fill(2 * index + 1, it);
+    };
+    size_t next_index(size_t index) const;
+    size_t prev_index(size_t index) const;
+    template <typename Compare>
+    size_t search(const K& key, Compare go_right) const;
+
+public:
+    using iterator = Frozen_cartesian_tree_iterator<K, P>;
+
+    Frozen_cartesian_tree() : nodes(1), sz(0) {};
+    explicit Frozen_cartesian_tree(const Cartesian_tree<K, P>& tree) : nodes(tree.size() + 1), sz(tree.size()) {
+        auto it = tree.begin();
+        fill(1, it);
+    };
+    [[nodiscard]] bool empty() const {
+        return sz == 0;
+    };
+    [[nodiscard]] size_t size() const {
+        return sz;
+    };
+    iterator begin() const {
+        return iterator(next_index(0), this);
+    };
+    iterator end() const {
+        return iterator(0, this);
+    };
+    iterator find(const K& key) const {
+        auto index = search(key, [](const K& lhs, const K& rhs) { return lhs < rhs; });
+        return iterator(index && !(key < nodes[index].key) ? index : 0, this);
+    };
+    iterator lower_bound(const K& key) const {
+        return iterator(search(key, [](const K& lhs, const K& rhs) { return lhs < rhs; }), this);
+    };
+    iterator upper_bound(const K& key) const {
+        return iterator(search(key, [](const K& lhs, const K& rhs) { return !(rhs < lhs); }), this);
+    };
+    std::pair<iterator, iterator> range(const K& lo, const K& hi) const {     // [lo, hi)
+        return std::make_pair(lower_bound(lo), lower_bound(hi));
+    };
+};
+
+template <typename K, typename P>
+size_t Frozen_cartesian_tree<K, P>::next_index(size_t index) const {
+    if (index == 0) {       // leftmost element
+        if (sz == 0)
+            return 0;
+
+        index = 1;
+        while (2 * index <= sz)
+            index *= 2;
+
+        return index;
+    }
+
+    if (2 * index + 1 <= sz) {
+        index = 2 * index + 1;
+        while (2 * index <= sz)
+            index *= 2;
+
+        return index;
+    }
+
+    while (index & 1)
+        index >>= 1;
+
+    return index >> 1;
+}
+
+template <typename K, typename P>
+size_t Frozen_cartesian_tree<K, P>::prev_index(size_t index) const {
+    if (index == 0) {       // rightmost element
+        if (sz == 0)
+            return 0;
+
+        index = 1;
+        while (2 * index + 1 <= sz)
+            index = 2 * index + 1;
+
+        return index;
+    }
+
+    if (2 * index <= sz) {
+        index = 2 * index;
+        while (2 * index + 1 <= sz)
+            index = 2 * index + 1;
+
+        return index;
+    }
+
+    while (index && !(index & 1))
+        index >>= 1;
+
+    return index >> 1;
+}
+
+template <typename K, typename P>
+template <typename Compare>
+size_t Frozen_cartesian_tree<K, P>::search(const K& key, Compare go_right) const {     // branchless descent
+    constexpr size_t prefetch_distance = 64 / sizeof(Frozen_node<K, P>) > 1 ? 64 / sizeof(Frozen_node<K, P>) : 1;
+
+    size_t index = 1;
+    while (index <= sz) {
+#if defined(__GNUC__)
+        if (prefetch_distance * index <= sz)
+            __builtin_prefetch(nodes.data() + prefetch_distance * index);
+#endif
+        index = 2 * index + static_cast<size_t>(go_right(nodes[index].key, key));
+    }
+
+#if defined(__GNUC__)
+    return index >> __builtin_ffsll(static_cast<long long>(~index));
+#else
+    while (index & 1)
+        index >>= 1;
+
+    return index >> 1;
+#endif
+}
+
+template <typename K, typename P>
+Frozen_cartesian_tree<K, P> freeze(const Cartesian_tree<K, P>& tree) {
+    return Frozen_cartesian_tree<K, P>(tree);
+}
+
 /*template <typename K, typename P>
 std::tuple<Cartesian_tree<K, P>, Node<K, P> *, Cartesian_tree<K, P>> split(Cartesian_tree<K, P> tree, const K& pivot) {
     auto tmp_split = split(tree->top, pivot);
@@ -295,6 +839,7 @@ void merge(Cartesian_tree<K, P>& lhs, Cartesian_tree<K, P>& rhs) {
     }
 
     lhs.top = merge(lhs.top, rhs.top);
+    lhs.top->predecessor = nullptr;
     lhs.sz += rhs.sz;
     lhs.maximum = lhs.top;
     while (lhs.maximum->right)
@@ -315,10 +860,15 @@ void merge(Cartesian_tree<K, P>& lhs, Cartesian_tree<K, P>&& rhs) {
     }
 
     lhs.top = merge(lhs.top, rhs.top);
+    lhs.top->predecessor = nullptr;
     lhs.sz += rhs.sz;
     lhs.maximum = lhs.top;
     while (lhs.maximum->right)
         lhs.maximum = lhs.maximum->right;
+
+    rhs.sz = 0;
+    rhs.top = nullptr;
+    rhs.maximum = nullptr;
 }
 
 template <typename K, typename P>
@@ -355,6 +905,8 @@ Cartesian_tree<K, P> build_cartesian_tree(std::pair<K, P> *buffer, size_t sz) {
             auto new_node = new Node<K, P>(tmp.first, tmp.second);
             new_node->predecessor = ptr;
             new_node->left = ptr->right;
+            if (new_node->left)
+                new_node->left->predecessor = new_node;
             ptr->right = new_node;
 
             result.maximum = new_node;
@@ -368,14 +920,138 @@ template <typename K, typename P>
 Cartesian_tree<K, P> insert(Cartesian_tree<K, P>&& tree, const std::pair<K, P>& element) {
     auto split_result = split(std::move(tree), element.first);
 
-    if (std::get<1>(split_result)) {
-        merge(std::get<0>(split_result), std::get<2>(split_result));
-        return std::get<0>(split_result);
+    auto middle = std::get<1>(split_result);
+    if (middle) {
+        middle->left = nullptr;
+        middle->right = nullptr;
+        merge(std::get<0>(split_result), Cartesian_tree<K, P>(middle));
+    } else
+        merge(std::get<0>(split_result), Cartesian_tree<K, P>(element.first, element.second));
+    merge(std::get<0>(split_result), std::get<2>(split_result));
+
+    return std::move(std::get<0>(split_result));
+}
+
+template <typename K, typename P, typename FwdIt>
+Node<K, P> *build_from_sorted(FwdIt first, FwdIt last, size_t& sz) {
+    Node<K, P> *top = nullptr;
+    Node<K, P> *rightmost = nullptr;
+    sz = 0;
+
+    for (; first != last; ++first) {
+        if (rightmost && !(rightmost->key < first->first))
+            continue;
+
+        auto new_node = new Node<K, P>(first->first, first->second);
+        Node<K, P> *last_popped = nullptr;
+        auto ptr = rightmost;
+        while (ptr && ptr->priority > new_node->priority) {
+            last_popped = ptr;
+            ptr = ptr->predecessor;
+        }
+
+        new_node->left = last_popped;
+        if (last_popped)
+            last_popped->predecessor = new_node;
+        new_node->predecessor = ptr;
+        if (ptr)
+            ptr->right = new_node;
+        else
+            top = new_node;
+
+        rightmost = new_node;
+        ++sz;
     }
 
-    merge(std::get<0>(split_result), Cartesian_tree<K, P>(element.first, element.second));
-    merge(std::get<0>(split_result), std::get<2>(split_result));
+    return top;
+}
 
-    return std::get<0>(split_result);
+template <typename K, typename P>
+Node<K, P> *unite(Node<K, P> *lhs, Node<K, P> *rhs, size_t& duplicates) {     // keys of lhs win over equal keys of rhs
+    if (!lhs)
+        return rhs;
+    if (!rhs)
+        return lhs;
+
+    if (lhs->priority <= rhs->priority) {
+        auto tmp_split = split(rhs, lhs->key);
+
+        auto twin = std::get<1>(tmp_split);
+        if (twin) {
+            twin->left = nullptr;
+            twin->right = nullptr;
+            delete twin;
+            ++duplicates;
+        }
+
+        lhs->left = unite(lhs->left, std::get<0>(tmp_split), duplicates);
+        if (lhs->left)
+            lhs->left->predecessor = lhs;
+        lhs->right = unite(lhs->right, std::get<2>(tmp_split), duplicates);
+        if (lhs->right)
+            lhs->right->predecessor = lhs;
+
+        return lhs;
+    }
+
+    auto tmp_split = split(lhs, rhs->key);
+
+    rhs->left = unite(std::get<0>(tmp_split), rhs->left, duplicates);
+    if (rhs->left)
+        rhs->left->predecessor = rhs;
+    rhs->right = unite(std::get<2>(tmp_split), rhs->right, duplicates);
+    if (rhs->right)
+        rhs->right->predecessor = rhs;
+
+    auto twin = std::get<1>(tmp_split);
+    if (!twin)
+        return rhs;
+
+    ++duplicates;
+
+    auto left = rhs->left;
+    auto right = rhs->right;
+    if (left)
+        left->predecessor = nullptr;
+    if (right)
+        right->predecessor = nullptr;
+    rhs->left = nullptr;
+    rhs->right = nullptr;
+    delete rhs;
+
+    twin->left = nullptr;
+    twin->right = nullptr;
+    twin->predecessor = nullptr;
+    right = merge(twin, right);
+    right->predecessor = nullptr;
+
+    return merge(left, right);
 }
 
+template <typename K, typename P, typename FwdIt>
+Cartesian_tree<K, P> insert_batch(Cartesian_tree<K, P>&& tree, FwdIt first, FwdIt last) {
+    if (!std::is_sorted(first, last, [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; }))
+        throw std::invalid_argument("unsorted batch");
+
+    size_t batch_sz = 0;
+    size_t duplicates = 0;
+    auto batch = build_from_sorted<K, P>(first, last, batch_sz);
+
+    Cartesian_tree<K, P> result;
+    result.top = unite(tree.top, batch, duplicates);
+    result.sz = tree.sz + batch_sz - duplicates;
+
+    tree.top = nullptr;
+    tree.maximum = nullptr;
+    tree.sz = 0;
+
+    if (result.top) {
+        result.top->predecessor = nullptr;
+
+        result.maximum = result.top;
+        while (result.maximum->right)
+            result.maximum = result.maximum->right;
+    }
+
+    return result;
+}
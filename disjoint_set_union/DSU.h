@@ -9,46 +9,89 @@
 #endif //DISJOINTSETUNION_DSU_H
 
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 template <typename N>
+struct No_aggregate {
+    struct value_type {};
+
+    static value_type make(const N&) {
+        return value_type();
+    };
+    static void combine(value_type&, const value_type&) {};
+};
+
+template <typename N>
+struct Sum_aggregate {
+    using value_type = N;
+
+    static value_type make(const N& data) {
+        return data;
+    };
+    static void combine(value_type& to, const value_type& from) {
+        to += from;
+    };
+};
+
+template <typename N>
+struct Min_aggregate {
+    using value_type = N;
+
+    static value_type make(const N& data) {
+        return data;
+    };
+    static void combine(value_type& to, const value_type& from) {
+        if (from < to)
+            to = from;
+    };
+};
+
+template <typename N>
+struct Max_aggregate {
+    using value_type = N;
+
+    static value_type make(const N& data) {
+        return data;
+    };
+    static void combine(value_type& to, const value_type& from) {
+        if (to < from)
+            to = from;
+    };
+};
+
+template <typename N, typename A = No_aggregate<N>>
 struct Node final {
     size_t rank;
     N data;
     Node *parent;
+    size_t size;        // size and aggregate are valid in roots only
+    Node *next;         // circular list of the members of the set
+    typename A::value_type aggregate;
 
-    Node() : rank(0), data(N()), parent(nullptr) {};
-    Node(const Node& other) : rank(other.rank), data(other.data), parent(nullptr) {};
-    Node(Node&& other) noexcept : rank(other.rank), data(std::move(other.data)), parent(other.parent) {
-        other.parent = nullptr;
-        other.rank = 0;
-    };
+    Node() : rank(0), data(N()), parent(nullptr), size(1), next(this), aggregate(A::make(data)) {};
+    Node(const Node& other) : rank(other.rank), data(other.data), parent(nullptr), size(1), next(this), aggregate(A::make(data)) {};
+    Node(Node&& other) = delete;        // members and children point at the node, so it never changes its address
     Node& operator= (const Node& other) {
         rank = other.rank;
         data = other.data;
         parent = nullptr;
+        size = 1;
+        next = this;
+        aggregate = A::make(data);
 
         return *this;
     };
-    Node& operator= (Node&& other) noexcept {
-        rank = other.rank;
-        data = std::move(other.data);
-        parent = other.data;
-
-        other.rank = 0;
-        other.data = nullptr;
-
-        return *this;
-    };
+    Node& operator= (Node&& other) = delete;
     ~Node() noexcept = default;
-    explicit Node(const N& new_data_) : data(new_data_), rank(0), parent(nullptr) {};
-    explicit Node(N&& new_data_) : data(std::move(new_data_)), rank(0), parent(nullptr) {};
+    explicit Node(const N& new_data_) : rank(0), data(new_data_), parent(nullptr), size(1), next(this), aggregate(A::make(data)) {};
+    explicit Node(N&& new_data_) : rank(0), data(std::move(new_data_)), parent(nullptr), size(1), next(this), aggregate(A::make(data)) {};
     Node *root();
 };
 
-template <typename N>
-Node<N> *Node<N>::root() {
-    Node<N> *result = parent;
+template <typename N, typename A>
+Node<N, A> *Node<N, A>::root() {
+    Node<N, A> *result = parent;
     if (!result)
         return this;
 
@@ -58,19 +101,21 @@ Node<N> *Node<N>::root() {
     return result;
 }
 
-template <typename N>
+template <typename N, typename A = No_aggregate<N>>
 class DSU final {
-    std::vector<Node<N> *> universum;
+    std::vector<Node<N, A> *> universum;
+    size_t components;
 
 public:
-    DSU() = default;
+    DSU() : components(0) {};
     DSU(const DSU& other) = delete;
-    DSU(DSU&& other) noexcept : universum(other.universum.size()) {
+    DSU(DSU&& other) noexcept : universum(other.universum.size()), components(other.components) {
         for (size_t i = 0, end_ = other.universum.size(); i < end_; ++i) {
             universum[i] = other.universum[i];
         }
 
         other.universum.clear();
+        other.components = 0;
     };
     DSU& operator= (const DSU& other) = delete;
     DSU& operator= (DSU&& other) noexcept {
@@ -78,6 +123,8 @@ public:
             delete it;
 
         universum = std::move(other.universum);
+        components = other.components;
+        other.components = 0;
 
         return *this;
     };
@@ -85,30 +132,62 @@ public:
         for (auto& it : universum)
             delete it;
     };
-    explicit DSU(size_t sz) : universum(sz, nullptr) {};
+    explicit DSU(size_t sz) : universum(sz, nullptr), components(0) {};
     void reserve(size_t cap) {
         universum.reserve(cap);
     };
-    Node<N> *add_element(const N& data);
-    Node<N> *add_element(N&& data);
-    void unite(Node<N> *lhs, Node<N> *rhs);
-    bool equivalent(Node<N> *lhs, Node<N> *rhs) const;
+    [[nodiscard]] size_t number_of_components() const {
+        return components;
+    };
+    Node<N, A> *add_element(const N& data);
+    Node<N, A> *add_element(N&& data);
+    void unite(Node<N, A> *lhs, Node<N, A> *rhs);
+    bool equivalent(Node<N, A> *lhs, Node<N, A> *rhs) const;
+    size_t set_size(Node<N, A> *element) const {
+        if (element == nullptr)
+            throw std::invalid_argument("element");
+
+        return element->root()->size;
+    };
+    const typename A::value_type& aggregate(Node<N, A> *element) const {
+        if (element == nullptr)
+            throw std::invalid_argument("element");
+
+        return element->root()->aggregate;
+    };
+    template <typename F>
+    void for_each_member(Node<N, A> *element, F f) const;
 };
 
-template <typename N>
-Node<N> *DSU<N>::add_element(const N &data) {
-    universum.push_back(new Node<N>(data));
+template <typename N, typename A>
+Node<N, A> *DSU<N, A>::add_element(const N &data) {
+    universum.push_back(new Node<N, A>(data));
+    ++components;
     return universum.back();
 }
 
-template <typename N>
-Node<N> *DSU<N>::add_element(N&& data) {
-    universum.push_back(new Node<N>(std::move(data)));
+template <typename N, typename A>
+Node<N, A> *DSU<N, A>::add_element(N&& data) {
+    universum.push_back(new Node<N, A>(std::move(data)));
+    ++components;
     return universum.back();
 }
 
-template <typename N>
-bool DSU<N>::equivalent(Node<N> *lhs, Node<N> *rhs) const {
+template <typename N, typename A>
+template <typename F>
+void DSU<N, A>::for_each_member(Node<N, A> *element, F f) const {      // O(size of the set)
+    if (element == nullptr)
+        throw std::invalid_argument("element");
+
+    auto it = element;
+    do {
+        f(*it);
+        it = it->next;
+    } while (it != element);
+}
+
+template <typename N, typename A>
+bool DSU<N, A>::equivalent(Node<N, A> *lhs, Node<N, A> *rhs) const {
     if (lhs == nullptr || rhs == nullptr)
         throw std::invalid_argument("elements");
     if (lhs == rhs)
@@ -127,8 +206,8 @@ bool DSU<N>::equivalent(Node<N> *lhs, Node<N> *rhs) const {
     return (lparent == rhs->root());
 }
 
-template <typename N>
-void DSU<N>::unite(Node<N> *lhs, Node<N> *rhs) {
+template <typename N, typename A>
+void DSU<N, A>::unite(Node<N, A> *lhs, Node<N, A> *rhs) {
     if (lhs == nullptr || rhs == nullptr)
         throw std::invalid_argument("elements");
 
@@ -145,12 +224,16 @@ void DSU<N>::unite(Node<N> *lhs, Node<N> *rhs) {
     if (lparent == rparent)
         return;
     else {
-        if (lparent->rank < rparent->rank) {
-            lparent->parent = rparent;
-        } else {
-            rparent->parent = lparent;
-            if (lparent->rank == rparent->rank)
-                ++lparent->rank;
-        }
+        if (lparent->rank < rparent->rank)
+            std::swap(lparent, rparent);
+
+        rparent->parent = lparent;
+        if (lparent->rank == rparent->rank)
+            ++lparent->rank;
+
+        lparent->size += rparent->size;
+        A::combine(lparent->aggregate, rparent->aggregate);
+        std::swap(lparent->next, rparent->next);
+        --components;
     }
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#ifndef DISJOINTSETUNION_CONCURRENT_DSU_H
+#define DISJOINTSETUNION_CONCURRENT_DSU_H
+
+#endif //DISJOINTSETUNION_CONCURRENT_DSU_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+class Concurrent_DSU final {        // lock-free, randomized linking by index (Jayanti-Tarjan) with path splitting
+    std::unique_ptr<std::atomic<uint32_t>[]> parents;
+    size_t sz;
+    uint32_t seed;
+
+    uint32_t priority(uint32_t element) const {     // bijective mix, so priorities never tie
+        element ^= seed;
+        element ^= element >> 16;
+        element *= 0x85ebca6bU;
+        element ^= element >> 13;
+        element *= 0xc2b2ae35U;
+        element ^= element >> 16;
+
+        return element;
+    };
+    void check_index(uint32_t element) const {
+        if (element >= sz)
+            throw std::invalid_argument("elements");
+    };
+    static size_t checked_size(size_t new_sz_) {       // called from the initializer, before the array is allocated
+        if (new_sz_ > max_size)
+            throw std::length_error("universum");
+
+        return new_sz_;
+    };
+    uint32_t find_root(uint32_t element) const;
+
+public:
+    static constexpr uint32_t max_size = std::numeric_limits<uint32_t>::max();
+
+    explicit Concurrent_DSU(size_t new_sz_, uint32_t new_seed_ = 0x9e3779b9U) : parents(new std::atomic<uint32_t>[checked_size(new_sz_)]),
+                                                                                 sz(new_sz_), seed(new_seed_) {
+        for (uint32_t i = 0; i < sz; ++i)
+            parents[i].store(i, std::memory_order_relaxed);
+    };
+    Concurrent_DSU(const Concurrent_DSU& other) = delete;
+    Concurrent_DSU& operator= (const Concurrent_DSU& other) = delete;
+    Concurrent_DSU(Concurrent_DSU&& other) noexcept = default;
+    Concurrent_DSU& operator= (Concurrent_DSU&& other) noexcept = default;
+    ~Concurrent_DSU() noexcept = default;
+    [[nodiscard]] size_t size() const {
+        return sz;
+    };
+    uint32_t find(uint32_t element) const {
+        check_index(element);
+        return find_root(element);
+    };
+    bool unite(uint32_t lhs, uint32_t rhs);
+    bool same_set(uint32_t lhs, uint32_t rhs) const;
+};
+
+inline uint32_t Concurrent_DSU::find_root(uint32_t element) const {
+    while (true) {
+        auto parent = parents[element].load(std::memory_order_acquire);
+        if (parent == element)
+            return element;
+
+        auto grandparent = parents[parent].load(std::memory_order_acquire);
+        if (parent != grandparent)
+            parents[element].compare_exchange_weak(parent, grandparent, std::memory_order_acq_rel, std::memory_order_relaxed);
+
+        element = parent;
+    }
+}
+
+inline bool Concurrent_DSU::unite(uint32_t lhs, uint32_t rhs) {     // false if the elements were already in one set
+    check_index(lhs);
+    check_index(rhs);
+
+    while (true) {
+        lhs = find_root(lhs);
+        rhs = find_root(rhs);
+
+        if (lhs == rhs)
+            return false;
+
+        if (priority(lhs) > priority(rhs))
+            std::swap(lhs, rhs);
+
+        auto expected = lhs;
+        if (parents[lhs].compare_exchange_strong(expected, rhs, std::memory_order_acq_rel, std::memory_order_relaxed))
+            return true;
+    }
+}
+
+inline bool Concurrent_DSU::same_set(uint32_t lhs, uint32_t rhs) const {
+    check_index(lhs);
+    check_index(rhs);
+
+    while (true) {
+        lhs = find_root(lhs);
+        rhs = find_root(rhs);
+
+        if (lhs == rhs)
+            return true;
+        if (parents[lhs].load(std::memory_order_acquire) == lhs)
+            return false;
+    }
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#ifndef DISJOINTSETUNION_FLAT_DSU_H
+#define DISJOINTSETUNION_FLAT_DSU_H
+
+#endif //DISJOINTSETUNION_FLAT_DSU_H
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template <typename N = void>
+class Flat_DSU;
+
+template <>
+class Flat_DSU<void> {      // elements are plain indices, no per-element allocation
+protected:
+    std::vector<uint32_t> parents;
+    std::vector<uint8_t> ranks;
+
+    void check_index(uint32_t element) const {
+        if (element >= parents.size())
+            throw std::invalid_argument("elements");
+    };
+    static size_t checked_size(size_t sz) {        // called from the initializers, before anything is allocated
+        if (sz > max_size)
+            throw std::length_error("universum");
+
+        return sz;
+    };
+
+public:
+    static constexpr uint32_t max_size = std::numeric_limits<uint32_t>::max();
+
+    Flat_DSU() = default;
+    explicit Flat_DSU(size_t sz) : parents(checked_size(sz)), ranks(sz, 0) {
+        for (uint32_t i = 0; i < sz; ++i)
+            parents[i] = i;
+    };
+    void reserve(size_t cap) {
+        parents.reserve(checked_size(cap));
+        ranks.reserve(cap);
+    };
+    [[nodiscard]] size_t size() const {
+        return parents.size();
+    };
+    uint32_t add_element() {
+        if (parents.size() >= max_size)
+            throw std::length_error("universum");
+
+        auto result = static_cast<uint32_t>(parents.size());
+        parents.push_back(result);
+        ranks.push_back(0);
+
+        return result;
+    };
+    uint32_t find(uint32_t element);
+    uint32_t link(uint32_t lroot, uint32_t rroot);
+    uint32_t unite(uint32_t lhs, uint32_t rhs);
+    bool equivalent(uint32_t lhs, uint32_t rhs) {
+        check_index(lhs);
+        check_index(rhs);
+
+        return find(lhs) == find(rhs);
+    };
+};
+
+inline uint32_t Flat_DSU<void>::find(uint32_t element) {        // single pass with path halving
+    check_index(element);
+
+    while (parents[element] != element) {
+        parents[element] = parents[parents[element]];
+        element = parents[element];
+    }
+
+    return element;
+}
+
+inline uint32_t Flat_DSU<void>::link(uint32_t lroot, uint32_t rroot) {      // both must be distinct roots, returns the new one
+    if (ranks[lroot] < ranks[rroot])
+        std::swap(lroot, rroot);
+
+    parents[rroot] = lroot;
+    if (ranks[lroot] == ranks[rroot])
+        ++ranks[lroot];
+
+    return lroot;
+}
+
+inline uint32_t Flat_DSU<void>::unite(uint32_t lhs, uint32_t rhs) {        // returns the root of the united set
+    auto lparent = find(lhs);
+    auto rparent = find(rhs);
+
+    if (lparent == rparent)
+        return lparent;
+
+    return link(lparent, rparent);
+}
+
+template <typename N>
+class Flat_DSU final : public Flat_DSU<void> {      // payload lives in its own array, indexed like the parents
+    std::vector<N> payload;
+
+public:
+    Flat_DSU() = default;
+    explicit Flat_DSU(size_t sz) : Flat_DSU<void>(sz), payload(sz) {};
+    void reserve(size_t cap) {
+        Flat_DSU<void>::reserve(cap);
+        payload.reserve(cap);
+    };
+    uint32_t add_element(const N& data) {
+        auto result = Flat_DSU<void>::add_element();
+        payload.push_back(data);
+
+        return result;
+    };
+    uint32_t add_element(N&& data) {
+        auto result = Flat_DSU<void>::add_element();
+        payload.push_back(std::move(data));
+
+        return result;
+    };
+    N& data(uint32_t element) {
+        check_index(element);
+        return payload[element];
+    };
+    const N& data(uint32_t element) const {
+        check_index(element);
+        return payload[element];
+    };
+};
@@ -0,0 +1,249 @@
+#pragma once
+
+#ifndef DISJOINTSETUNION_MAPPED_DSU_H
+#define DISJOINTSETUNION_MAPPED_DSU_H
+
+#endif //DISJOINTSETUNION_MAPPED_DSU_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class Mapped_DSU final {        // parents and ranks live in a memory-mapped file and survive restarts
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t size;
+        uint64_t capacity;
+    };
+
+    static constexpr char file_magic[8] = {'D', 'S', 'U', 'M', 'A', 'P', '\0', '\0'};
+    static constexpr uint32_t file_version = 1;
+    static constexpr unsigned rank_shift = 56;     // every word holds the parent in the low 56 bits and the rank in the high 8
+    static constexpr uint64_t parent_mask = (uint64_t(1) << rank_shift) - 1;
+
+    int fd;
+    void *mapping;
+    size_t mapped_bytes;
+
+    Header *header() const {        // every access goes through here, so a moved-from object throws instead of crashing
+        if (!mapping)
+            throw std::logic_error("moved-from DSU");
+
+        return static_cast<Header *>(mapping);
+    };
+    uint64_t *words() const {
+        return reinterpret_cast<uint64_t *>(static_cast<char *>(mapping) + sizeof(Header));
+    };
+    uint64_t parent(uint64_t element) const {
+        return words()[element] & parent_mask;
+    };
+    uint64_t rank(uint64_t element) const {
+        return words()[element] >> rank_shift;
+    };
+    void set_parent(uint64_t element, uint64_t new_parent) {
+        words()[element] = (words()[element] & ~parent_mask) | new_parent;
+    };
+    void check_index(uint64_t element) const {
+        if (element >= header()->size)
+            throw std::invalid_argument("elements");
+    };
+    static size_t bytes_for(uint64_t capacity) {
+        return sizeof(Header) + capacity * sizeof(uint64_t);
+    };
+    void map(size_t bytes);
+    void unmap() noexcept;
+    void grow(uint64_t capacity);
+
+public:
+    static constexpr uint64_t max_size = parent_mask;
+
+    explicit Mapped_DSU(const std::string& path, size_t sz = 0);
+    Mapped_DSU(const Mapped_DSU& other) = delete;
+    Mapped_DSU& operator= (const Mapped_DSU& other) = delete;
+    Mapped_DSU(Mapped_DSU&& other) noexcept : fd(other.fd), mapping(other.mapping), mapped_bytes(other.mapped_bytes) {
+        other.fd = -1;
+        other.mapping = nullptr;
+        other.mapped_bytes = 0;
+    };
+    Mapped_DSU& operator= (Mapped_DSU&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        unmap();
+        if (fd >= 0)
+            ::close(fd);
+
+        fd = other.fd;
+        mapping = other.mapping;
+        mapped_bytes = other.mapped_bytes;
+
+        other.fd = -1;
+        other.mapping = nullptr;
+        other.mapped_bytes = 0;
+
+        return *this;
+    };
+    ~Mapped_DSU() noexcept {
+        unmap();
+        if (fd >= 0)
+            ::close(fd);
+    };
+    [[nodiscard]] size_t size() const {
+        return header()->size;
+    };
+    void reserve(size_t cap) {
+        if (cap > header()->capacity)
+            grow(cap);
+    };
+    uint64_t add_element();
+    uint64_t find(uint64_t element);
+    uint64_t unite(uint64_t lhs, uint64_t rhs);
+    bool equivalent(uint64_t lhs, uint64_t rhs) {
+        return find(lhs) == find(rhs);
+    };
+    void flatten();
+    void flush();
+};
+
+inline void Mapped_DSU::map(size_t bytes) {
+    mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+
+    mapped_bytes = bytes;
+}
+
+inline void Mapped_DSU::unmap() noexcept {
+    if (mapping)
+        ::munmap(mapping, mapped_bytes);
+
+    mapping = nullptr;
+    mapped_bytes = 0;
+}
+
+inline void Mapped_DSU::grow(uint64_t capacity) {
+    if (capacity > max_size)
+        throw std::length_error("universum");
+
+    // the old mapping is released only once the new one exists, so a failure leaves the object usable;
+    // a longer file than the header needs is accepted on open
+    auto bytes = bytes_for(capacity);
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+        throw std::system_error(errno, std::generic_category(), "ftruncate");
+
+    auto grown = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (grown == MAP_FAILED)
+        throw std::system_error(errno, std::generic_category(), "mmap");
+
+    unmap();
+    mapping = grown;
+    mapped_bytes = bytes;
+    header()->capacity = capacity;
+}
+
+inline Mapped_DSU::Mapped_DSU(const std::string& path, size_t sz) : fd(-1), mapping(nullptr), mapped_bytes(0) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), "open");
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        auto error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "fstat");
+    }
+
+    try {
+        if (info.st_size == 0) {
+            if (::ftruncate(fd, static_cast<off_t>(bytes_for(0))) != 0)
+                throw std::system_error(errno, std::generic_category(), "ftruncate");
+
+            map(bytes_for(0));
+            std::memcpy(header()->magic, file_magic, sizeof(file_magic));
+            header()->version = file_version;
+            header()->reserved = 0;
+            header()->size = 0;
+            header()->capacity = 0;
+        } else {
+            if (static_cast<size_t>(info.st_size) < sizeof(Header))
+                throw std::runtime_error("not a DSU file");
+
+            map(static_cast<size_t>(info.st_size));
+            if (std::memcmp(header()->magic, file_magic, sizeof(file_magic)) != 0 || header()->version != file_version ||
+                bytes_for(header()->capacity) > static_cast<size_t>(info.st_size) || header()->size > header()->capacity)
+                throw std::runtime_error("not a DSU file");
+        }
+
+        if (sz > header()->capacity)
+            grow(sz);
+        while (header()->size < sz)
+            add_element();
+    } catch (...) {
+        unmap();
+        ::close(fd);
+        throw;
+    }
+}
+
+inline uint64_t Mapped_DSU::add_element() {
+    auto result = header()->size;
+    if (result == header()->capacity)
+        grow(result ? 2 * result : 1024);
+
+    words()[result] = result;
+    ++header()->size;
+
+    return result;
+}
+
+inline uint64_t Mapped_DSU::find(uint64_t element) {       // single pass with path halving
+    check_index(element);
+
+    while (parent(element) != element) {
+        set_parent(element, parent(parent(element)));
+        element = parent(element);
+    }
+
+    return element;
+}
+
+inline uint64_t Mapped_DSU::unite(uint64_t lhs, uint64_t rhs) {        // returns the root of the united set
+    auto lparent = find(lhs);
+    auto rparent = find(rhs);
+
+    if (lparent == rparent)
+        return lparent;
+
+    if (rank(lparent) < rank(rparent))
+        std::swap(lparent, rparent);
+
+    set_parent(rparent, lparent);
+    if (rank(lparent) == rank(rparent))
+        words()[lparent] += uint64_t(1) << rank_shift;
+
+    return lparent;
+}
+
+inline void Mapped_DSU::flatten() {        // afterwards every element points straight at its root
+    for (uint64_t i = 0, end_ = header()->size; i < end_; ++i)
+        set_parent(i, find(i));
+}
+
+inline void Mapped_DSU::flush() {
+    header();
+    if (::msync(mapping, mapped_bytes, MS_SYNC) != 0)
+        throw std::system_error(errno, std::generic_category(), "msync");
+}
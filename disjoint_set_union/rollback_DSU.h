@@ -0,0 +1,219 @@
+#pragma once
+
+#ifndef DISJOINTSETUNION_ROLLBACK_DSU_H
+#define DISJOINTSETUNION_ROLLBACK_DSU_H
+
+#endif //DISJOINTSETUNION_ROLLBACK_DSU_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+class Rollback_DSU final {      // union by rank without path compression, every link can be undone
+    std::vector<uint32_t> parents;
+    std::vector<uint8_t> ranks;
+    std::vector<std::pair<uint32_t, bool>> history;     // linked root and whether the rank of its new parent grew
+    size_t components;
+
+    void check_index(uint32_t element) const {
+        if (element >= parents.size())
+            throw std::invalid_argument("elements");
+    };
+
+public:
+    static constexpr uint32_t max_size = std::numeric_limits<uint32_t>::max();
+
+    explicit Rollback_DSU(size_t sz) : parents(sz), ranks(sz, 0), components(sz) {
+        if (sz > max_size)
+            throw std::length_error("universum");
+
+        for (uint32_t i = 0; i < sz; ++i)
+            parents[i] = i;
+    };
+    [[nodiscard]] size_t size() const {
+        return parents.size();
+    };
+    [[nodiscard]] size_t number_of_components() const {
+        return components;
+    };
+    uint32_t find(uint32_t element) const {
+        check_index(element);
+
+        while (parents[element] != element)
+            element = parents[element];
+
+        return element;
+    };
+    bool equivalent(uint32_t lhs, uint32_t rhs) const {
+        return find(lhs) == find(rhs);
+    };
+    bool unite(uint32_t lhs, uint32_t rhs);
+    [[nodiscard]] size_t checkpoint() const {
+        return history.size();
+    };
+    void rollback(size_t to);
+};
+
+inline bool Rollback_DSU::unite(uint32_t lhs, uint32_t rhs) {
+    auto lparent = find(lhs);
+    auto rparent = find(rhs);
+
+    if (lparent == rparent)
+        return false;
+
+    if (ranks[lparent] < ranks[rparent])
+        std::swap(lparent, rparent);
+
+    bool grew = ranks[lparent] == ranks[rparent];
+    parents[rparent] = lparent;
+    if (grew)
+        ++ranks[lparent];
+
+    history.emplace_back(rparent, grew);
+    --components;
+
+    return true;
+}
+
+inline void Rollback_DSU::rollback(size_t to) {
+    if (to > history.size())
+        throw std::invalid_argument("checkpoint");
+
+    while (history.size() > to) {
+        auto last = history.back();
+        history.pop_back();
+
+        auto& parent = parents[last.first];
+        if (last.second)
+            --ranks[parent];
+        parent = last.first;
+        ++components;
+    }
+}
+
+class Offline_dynamic_connectivity final {      // segment tree over time, answers every query in O(q log q log n)
+    enum class Event_type {
+        add,
+        remove,
+        query
+    };
+
+    struct Event {
+        Event_type type;
+        uint32_t first;
+        uint32_t second;
+    };
+
+    size_t vertices;
+    std::vector<Event> events;
+    size_t queries;
+
+    void check_vertices(uint32_t first, uint32_t second) const {
+        if (first >= vertices || second >= vertices)
+            throw std::invalid_argument("invalid vertices");
+    };
+    static void add_interval(std::vector<std::vector<std::pair<uint32_t, uint32_t>>>& tree, size_t index, size_t lo, size_t hi,
+                             size_t from, size_t to, const std::pair<uint32_t, uint32_t>& edge);
+    void traverse(const std::vector<std::vector<std::pair<uint32_t, uint32_t>>>& tree, size_t index, size_t lo, size_t hi,
+                  Rollback_DSU& dsu, std::vector<bool>& result) const;
+
+public:
+    explicit Offline_dynamic_connectivity(size_t new_vertices_) : vertices(new_vertices_), queries(0) {};
+    void reserve(size_t cap) {
+        events.reserve(cap);
+    };
+    void add_edge(uint32_t first, uint32_t second) {
+        check_vertices(first, second);
+        events.push_back({Event_type::add, first, second});
+    };
+    void remove_edge(uint32_t first, uint32_t second) {
+        check_vertices(first, second);
+        events.push_back({Event_type::remove, first, second});
+    };
+    size_t query(uint32_t first, uint32_t second) {        // returns the index of the answer in solve()
+        check_vertices(first, second);
+        events.push_back({Event_type::query, first, second});
+
+        return queries++;
+    };
+    std::vector<bool> solve() const;
+};
+
+inline void Offline_dynamic_connectivity::add_interval(std::vector<std::vector<std::pair<uint32_t, uint32_t>>>& tree, size_t index,
+                                                       size_t lo, size_t hi, size_t from, size_t to,
+                                                       const std::pair<uint32_t, uint32_t>& edge) {
+    if (to <= lo || hi <= from)
+        return;
+
+    if (from <= lo && hi <= to) {
+        tree[index].push_back(edge);
+        return;
+    }
+
+    size_t mid = lo + (hi - lo) / 2;
+    add_interval(tree, 2 * index, lo, mid, from, to, edge);
+    add_interval(tree, 2 * index + 1, mid, hi, from, to, edge);
+}
+
+inline void Offline_dynamic_connectivity::traverse(const std::vector<std::vector<std::pair<uint32_t, uint32_t>>>& tree, size_t index,
+                                                   size_t lo, size_t hi, Rollback_DSU& dsu, std::vector<bool>& result) const {
+    auto saved = dsu.checkpoint();
+    for (const auto& it : tree[index])
+        dsu.unite(it.first, it.second);
+
+    if (hi - lo == 1) {
+        const auto& event = events[lo];
+        if (event.type == Event_type::query)
+            result.push_back(dsu.equivalent(event.first, event.second));
+    } else {
+        size_t mid = lo + (hi - lo) / 2;
+        traverse(tree, 2 * index, lo, mid, dsu, result);
+        traverse(tree, 2 * index + 1, mid, hi, dsu, result);
+    }
+
+    dsu.rollback(saved);
+}
+
+inline std::vector<bool> Offline_dynamic_connectivity::solve() const {
+    std::vector<bool> result;
+    result.reserve(queries);
+    if (events.empty())
+        return result;
+
+    size_t timeline = events.size();
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> tree(4 * timeline);
+
+    std::map<std::pair<uint32_t, uint32_t>, std::vector<size_t>> alive;     // start times of the copies of every edge
+    for (size_t i = 0; i < timeline; ++i) {
+        const auto& event = events[i];
+        if (event.type == Event_type::query)
+            continue;
+
+        std::pair<uint32_t, uint32_t> edge = std::minmax(event.first, event.second);
+        if (event.type == Event_type::add) {
+            alive[edge].push_back(i);
+        } else {
+            auto iter = alive.find(edge);
+            if (iter == alive.end())
+                throw std::invalid_argument("edge to remove");
+
+            add_interval(tree, 1, 0, timeline, iter->second.back(), i, edge);
+            iter->second.pop_back();
+            if (iter->second.empty())
+                alive.erase(iter);
+        }
+    }
+
+    for (const auto& it : alive)
+        for (auto start : it.second)
+            add_interval(tree, 1, 0, timeline, start, timeline, it.first);
+
+    Rollback_DSU dsu(vertices);
+    traverse(tree, 1, 0, timeline, dsu, result);
+
+    return result;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#ifndef DISJOINTSETUNION_STREAM_CONNECTIVITY_H
+#define DISJOINTSETUNION_STREAM_CONNECTIVITY_H
+
+#endif //DISJOINTSETUNION_STREAM_CONNECTIVITY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "flat_DSU.h"
+
+template <typename V = uint64_t>
+class Stream_connectivity final {       // incremental components over an edge stream, vertices are added on first sight
+    std::unordered_map<V, uint32_t> ids;
+    Flat_DSU<> dsu;
+    std::vector<uint32_t> sizes;        // valid in roots only
+    size_t components;
+    std::vector<std::pair<uint32_t, uint32_t>> pending;
+    size_t batch_size;
+
+    uint32_t id_of(const V& vertex) {
+        auto iter = ids.find(vertex);
+        if (iter != ids.end())
+            return iter->second;
+
+        auto result = dsu.add_element();
+        sizes.push_back(1);
+        ++components;
+        ids.emplace(vertex, result);
+
+        return result;
+    };
+    uint32_t known_id(const V& vertex) const {
+        auto iter = ids.find(vertex);
+        if (iter == ids.end())
+            throw std::invalid_argument("unknown vertex");
+
+        return iter->second;
+    };
+
+public:
+    explicit Stream_connectivity(size_t new_batch_size_ = 4096) : components(0), batch_size(new_batch_size_ ? new_batch_size_ : 1) {
+        pending.reserve(batch_size);
+    };
+    void reserve(size_t vertices) {
+        ids.reserve(vertices);
+        dsu.reserve(vertices);
+        sizes.reserve(vertices);
+    };
+    void add_vertex(const V& vertex) {
+        id_of(vertex);
+    };
+    void add_edge(const V& first, const V& second) {
+        pending.emplace_back(id_of(first), id_of(second));
+        if (pending.size() >= batch_size)
+            flush();
+    };
+    template <typename INIt>
+    void add_edges(INIt begin, INIt end) {      // range of pairs of vertices
+        for (auto it = begin; it != end; ++it)
+            add_edge(it->first, it->second);
+    };
+    template <typename Source>
+    size_t consume(Source next);
+    void flush();
+    [[nodiscard]] size_t number_of_vertices() const {
+        return dsu.size();
+    };
+    size_t number_of_components() {
+        flush();
+        return components;
+    };
+    bool connected(const V& first, const V& second) {
+        if (first == second)
+            return true;
+        if (!ids.count(first) || !ids.count(second))
+            return false;
+
+        flush();
+        return dsu.find(known_id(first)) == dsu.find(known_id(second));
+    };
+    size_t component_size(const V& vertex) {
+        auto id = known_id(vertex);
+
+        flush();
+        return sizes[dsu.find(id)];
+    };
+};
+
+template <typename V>
+template <typename Source>
+size_t Stream_connectivity<V>::consume(Source next) {      // next(first, second) fills an edge and returns false at the end of the stream
+    size_t result = 0;
+    V first;
+    V second;
+    while (next(first, second)) {
+        add_edge(first, second);
+        ++result;
+    }
+
+    flush();
+    return result;
+}
+
+template <typename V>
+void Stream_connectivity<V>::flush() {      // the batch is reduced to distinct pairs of roots before any linking
+    size_t kept = 0;
+    for (const auto& it : pending) {
+        auto lparent = dsu.find(it.first);
+        auto rparent = dsu.find(it.second);
+        if (lparent == rparent)
+            continue;
+
+        pending[kept++] = std::make_pair(std::min(lparent, rparent), std::max(lparent, rparent));
+    }
+    pending.resize(kept);
+    std::sort(pending.begin(), pending.end());
+    pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+    for (const auto& it : pending) {
+        auto lparent = dsu.find(it.first);      // a root of the first pass, unless linked since
+        auto rparent = dsu.find(it.second);
+        if (lparent == rparent)
+            continue;
+
+        auto united = dsu.link(lparent, rparent);
+        sizes[united] = sizes[lparent] + sizes[rparent];
+        --components;
+    }
+
+    pending.clear();
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#ifndef GRAPH_BFS_H
+#define GRAPH_BFS_H
+
+#endif //GRAPH_BFS_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "CSR_graph.h"
+#include "parallel.h"
+
+namespace graph {
+    static constexpr size_t unreached = std::numeric_limits<size_t>::max();
+
+    inline size_t lowest_bit_index(uint64_t word) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(word);
+#else
+        size_t result = 0;
+        while (!(word & 1)) {
+            word >>= 1;
+            ++result;
+        }
+
+        return result;
+#endif
+    }
+
+    struct BFS_result {
+        std::vector<size_t> levels;     // unreached for vertices not reachable from the source
+        std::vector<size_t> parents;    // the source is its own parent
+    };
+
+    // direction-optimizing BFS (Beamer et al.): top-down steps over a vertex queue while the frontier is small,
+    // bottom-up steps over bitmaps while it covers a large part of the unexplored edges
+    template<typename G, typename R, typename = enable_if_csr_graph_t<G>, typename = enable_if_csr_graph_t<R>>
+    BFS_result bfs(const G &g, const R &reverse, size_t source, size_t threads = default_threads()) {
+        constexpr size_t alpha = 15;
+        constexpr size_t beta = 18;
+        constexpr size_t grain = 1024;      // multiple of 64, so bottom-up chunks never share a bitmap word
+
+        size_t n = g.number_of_verteces();
+        if (source >= n)
+            throw std::invalid_argument("invalid vertex");
+        if (reverse.number_of_verteces() != n)
+            throw std::invalid_argument("reverse graph");
+
+        if (!threads)
+            threads = 1;
+
+        BFS_result result;
+        result.levels.assign(n, unreached);
+        std::unique_ptr<std::atomic<size_t>[]> parents(new std::atomic<size_t>[n]);
+        for (size_t i = 0; i < n; ++i)
+            parents[i].store(unreached, std::memory_order_relaxed);
+
+        parents[source].store(source, std::memory_order_relaxed);
+        result.levels[source] = 0;
+
+        size_t words = (n + 63) / 64;
+        std::vector<uint64_t> front_bitmap(words);
+        std::vector<uint64_t> next_bitmap(words);
+        std::vector<size_t> queue(1, source);
+        std::vector<std::vector<size_t>> local_queues(threads);
+        std::vector<size_t> local_counts(threads);
+
+        size_t unexplored_edges = 0;
+        for (size_t i = 0; i < n; ++i)
+            unexplored_edges += reverse.degree(i);
+        unexplored_edges -= reverse.degree(source);
+
+        size_t level = 0;
+        bool bottom_up = false;
+        size_t frontier_size = 1;
+        while (frontier_size) {
+            size_t frontier_edges = 0;
+            if (!bottom_up) {
+                for (auto it : queue)
+                    frontier_edges += g.degree(it);
+                bottom_up = frontier_edges > unexplored_edges / alpha;
+
+                if (bottom_up) {
+                    std::fill(front_bitmap.begin(), front_bitmap.end(), 0);
+                    for (auto it : queue)
+                        front_bitmap[it / 64] |= uint64_t(1) << (it % 64);
+                }
+            } else if (frontier_size < n / beta) {
+                bottom_up = false;
+
+                queue.clear();
+                for (size_t i = 0; i < words; ++i)
+                    for (auto word = front_bitmap[i]; word; word &= word - 1)
+                        queue.push_back(i * 64 + lowest_bit_index(word));
+            }
+
+            ++level;
+            if (bottom_up) {
+                std::fill(next_bitmap.begin(), next_bitmap.end(), 0);
+                std::fill(local_counts.begin(), local_counts.end(), 0);
+                parallel_for(0, n, threads, grain, [&](size_t thread, size_t lo, size_t hi) {
+                    size_t awake = 0;
+                    for (size_t v = lo; v < hi; ++v) {
+                        if (parents[v].load(std::memory_order_relaxed) != unreached)
+                            continue;
+
+                        for (auto it : reverse.adjacent(v)) {
+                            auto u = static_cast<size_t>(it);
+                            if (front_bitmap[u / 64] & (uint64_t(1) << (u % 64))) {
+                                parents[v].store(u, std::memory_order_relaxed);
+                                result.levels[v] = level;
+                                next_bitmap[v / 64] |= uint64_t(1) << (v % 64);
+                                ++awake;
+                                break;
+                            }
+                        }
+                    }
+                    local_counts[thread] += awake;
+                });
+
+                std::swap(front_bitmap, next_bitmap);
+                frontier_size = 0;
+                for (auto it : local_counts)
+                    frontier_size += it;
+            } else {
+                for (auto &it : local_queues)
+                    it.clear();
+                parallel_for(0, queue.size(), threads, 64, [&](size_t thread, size_t lo, size_t hi) {
+                    auto &local = local_queues[thread];
+                    for (size_t i = lo; i < hi; ++i) {
+                        auto u = queue[i];
+                        for (auto it : g.adjacent(u)) {
+                            auto v = static_cast<size_t>(it);
+                            auto expected = unreached;
+                            if (parents[v].load(std::memory_order_relaxed) == unreached &&
+                                parents[v].compare_exchange_strong(expected, u, std::memory_order_relaxed)) {
+                                result.levels[v] = level;
+                                local.push_back(v);
+                            }
+                        }
+                    }
+                });
+
+                queue.clear();
+                for (const auto &it : local_queues)
+                    queue.insert(queue.end(), it.begin(), it.end());
+                frontier_size = queue.size();
+            }
+
+            if (bottom_up) {
+                for (size_t i = 0; i < words; ++i)
+                    for (auto word = front_bitmap[i]; word; word &= word - 1)
+                        unexplored_edges -= reverse.degree(i * 64 + lowest_bit_index(word));
+            } else {
+                for (auto it : queue)
+                    unexplored_edges -= reverse.degree(it);
+            }
+        }
+
+        result.parents.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            result.parents[i] = parents[i].load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    template<typename G, typename = enable_if_csr_graph_t<G>>
+    BFS_result bfs(const G &g, size_t source, size_t threads = default_threads()) {
+        if (!g.is_directed())
+            return bfs(g, g, source, threads);
+
+        return bfs(g, transpose(g), source, threads);
+    }
+
+    template<typename N>
+    BFS_result bfs(const DirectedGraph<N> &g, size_t source, size_t threads = default_threads()) {
+        return bfs(freeze(g), source, threads);
+    }
+
+    template<typename N>
+    BFS_result bfs(const UndirectedGraph<N> &g, size_t source, size_t threads = default_threads()) {
+        auto frozen = freeze(g);
+        return bfs(frozen, frozen, source, threads);
+    }
+}
@@ -0,0 +1,351 @@
+#pragma once
+
+#ifndef GRAPH_CSR_GRAPH_H
+#define GRAPH_CSR_GRAPH_H
+
+#endif //GRAPH_CSR_GRAPH_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+
+namespace graph {
+    template<typename T>
+    class Adjacency_range final {
+        const T *first;
+        const T *last;
+
+    public:
+        Adjacency_range(const T *new_first_, const T *new_last_) : first(new_first_), last(new_last_) {};
+
+        const T *begin() const {
+            return first;
+        };
+
+        const T *end() const {
+            return last;
+        };
+
+        size_t size() const {
+            return last - first;
+        };
+
+        bool empty() const {
+            return first == last;
+        };
+
+        const T &operator[](size_t index) const {
+            return first[index];
+        };
+    };
+
+    // anything with the accessors of CSR_graph: vertex_type, weight_type, degree and indexable adjacent and
+    // adjacent_weights ranges; the CSR algorithms accept these, e.g. a Mapped_graph
+    template<typename G, typename = void>
+    struct is_csr_graph : std::false_type {};
+
+    template<typename G>
+    struct is_csr_graph<G, std::void_t<typename G::vertex_type, typename G::weight_type,
+                                       decltype(std::declval<const G &>().degree(size_t())),
+                                       decltype(std::declval<const G &>().adjacent(size_t())[0]),
+                                       decltype(std::declval<const G &>().adjacent_weights(size_t())[0])>>
+            : std::true_type {};
+
+    template<typename G>
+    using enable_if_csr_graph_t = std::enable_if_t<is_csr_graph<G>::value>;
+
+    // immutable compressed sparse row graph; an undirected edge is stored in the lists of both its ends
+    template<typename V = size_t, typename W = size_t>
+    class CSR_graph final {
+        bool directed;
+        size_t edges;
+        std::vector<size_t> offsets;
+        std::vector<V> targets;
+        std::vector<W> weights;
+
+    public:
+        using vertex_type = V;
+        using weight_type = W;
+
+        CSR_graph() : directed(true), edges(0), offsets(1, 0) {};
+
+        CSR_graph(bool new_directed_, std::vector<size_t> &&new_offsets_, std::vector<V> &&new_targets_,
+                  std::vector<W> &&new_weights_ = std::vector<W>()) : directed(new_directed_),
+                                                                     offsets(std::move(new_offsets_)),
+                                                                     targets(std::move(new_targets_)),
+                                                                     weights(std::move(new_weights_)) {
+            if (offsets.empty() || offsets.front() != 0 || offsets.back() != targets.size())
+                throw std::invalid_argument("offsets");
+            if (!weights.empty() && weights.size() != targets.size())
+                throw std::invalid_argument("weights");
+
+            edges = directed ? targets.size() : targets.size() / 2;
+        };
+
+        size_t number_of_verteces() const {
+            return offsets.size() - 1;
+        };
+
+        size_t number_of_edges() const {
+            return edges;
+        };
+
+        bool empty() const {
+            return offsets.size() == 1;
+        };
+
+        bool is_weighted() const {
+            return !weights.empty();
+        };
+
+        bool is_directed() const {
+            return directed;
+        };
+
+        size_t degree(size_t vertex) const {
+            return offsets[vertex + 1] - offsets[vertex];
+        };
+
+        Adjacency_range<V> adjacent(size_t vertex) const {
+            return Adjacency_range<V>(targets.data() + offsets[vertex], targets.data() + offsets[vertex + 1]);
+        };
+
+        Adjacency_range<W> adjacent_weights(size_t vertex) const {     // empty range for unweighted graphs
+            if (weights.empty())
+                return Adjacency_range<W>(nullptr, nullptr);
+
+            return Adjacency_range<W>(weights.data() + offsets[vertex], weights.data() + offsets[vertex + 1]);
+        };
+
+        const std::vector<size_t> &get_offsets() const {
+            return offsets;
+        };
+
+        const std::vector<V> &get_targets() const {
+            return targets;
+        };
+
+        const std::vector<W> &get_weights() const {
+            return weights;
+        };
+
+        CSR_graph transpose() const;
+    };
+
+    // every list reversed, as a CSR_graph whatever the source type
+    template<typename G, typename = enable_if_csr_graph_t<G>>
+    CSR_graph<typename G::vertex_type, typename G::weight_type> transpose(const G &g) {
+        using V = typename G::vertex_type;
+        using W = typename G::weight_type;
+
+        size_t n = g.number_of_verteces();
+        std::vector<size_t> new_offsets(n + 1, 0);
+        for (size_t i = 0; i < n; ++i)
+            for (const auto &it : g.adjacent(i))
+                ++new_offsets[static_cast<size_t>(it) + 1];
+        for (size_t i = 0; i < n; ++i)
+            new_offsets[i + 1] += new_offsets[i];
+
+        std::vector<size_t> cursor(new_offsets.begin(), new_offsets.end() - 1);
+        std::vector<V> new_targets(new_offsets.back());
+        std::vector<W> new_weights(g.is_weighted() ? new_offsets.back() : 0);
+        for (size_t i = 0; i < n; ++i) {
+            auto neighbours = g.adjacent(i);
+            for (size_t j = 0, end_ = neighbours.size(); j < end_; ++j) {
+                auto position = cursor[static_cast<size_t>(neighbours[j])]++;
+                new_targets[position] = static_cast<V>(i);
+                if (g.is_weighted())
+                    new_weights[position] = g.adjacent_weights(i)[j];
+            }
+        }
+
+        return CSR_graph<V, W>(g.is_directed(), std::move(new_offsets), std::move(new_targets), std::move(new_weights));
+    }
+
+    template<typename V, typename W>
+    CSR_graph<V, W> CSR_graph<V, W>::transpose() const {
+        if (!directed)
+            return *this;
+
+        return graph::transpose(*this);
+    }
+
+    // collects edges in any order and lays them out with one counting pass
+    template<typename V = size_t, typename W = size_t>
+    class CSR_builder final {
+        bool directed;
+        bool weighted;
+        size_t vertices;
+        std::vector<V> sources;
+        std::vector<V> targets;
+        std::vector<W> weights;
+
+    public:
+        CSR_builder(size_t new_vertices_, bool new_directed_, bool new_weighted_) : directed(new_directed_),
+                                                                                   weighted(new_weighted_),
+                                                                                   vertices(new_vertices_) {};
+
+        void reserve(size_t cap) {
+            sources.reserve(cap);
+            targets.reserve(cap);
+            if (weighted)
+                weights.reserve(cap);
+        };
+
+        size_t number_of_verteces() const {
+            return vertices;
+        };
+
+        void add_edge(size_t first, size_t last, W weight = W(1)) {
+            if (first >= vertices || last >= vertices)
+                throw std::invalid_argument("invalid vertices");
+
+            sources.push_back(static_cast<V>(first));
+            targets.push_back(static_cast<V>(last));
+            if (weighted)
+                weights.push_back(weight);
+        };
+
+        CSR_graph<V, W> build();
+    };
+
+    template<typename V, typename W>
+    CSR_graph<V, W> CSR_builder<V, W>::build() {
+        std::vector<size_t> offsets(vertices + 1, 0);
+        for (size_t i = 0, end_ = sources.size(); i < end_; ++i) {
+            ++offsets[static_cast<size_t>(sources[i]) + 1];
+            if (!directed)
+                ++offsets[static_cast<size_t>(targets[i]) + 1];
+        }
+        for (size_t i = 0; i < vertices; ++i)
+            offsets[i + 1] += offsets[i];
+
+        std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+        std::vector<V> result_targets(offsets.back());
+        std::vector<W> result_weights(weighted ? offsets.back() : 0);
+        for (size_t i = 0, end_ = sources.size(); i < end_; ++i) {
+            auto position = cursor[static_cast<size_t>(sources[i])]++;
+            result_targets[position] = targets[i];
+            if (weighted)
+                result_weights[position] = weights[i];
+
+            if (!directed) {
+                position = cursor[static_cast<size_t>(targets[i])]++;
+                result_targets[position] = sources[i];
+                if (weighted)
+                    result_weights[position] = weights[i];
+            }
+        }
+
+        sources.clear();
+        targets.clear();
+        weights.clear();
+
+        return CSR_graph<V, W>(directed, std::move(offsets), std::move(result_targets), std::move(result_weights));
+    }
+
+    template<typename V, typename W, typename G>
+    CSR_graph<V, W> freeze_adjacency(const G &g, bool directed) {
+        size_t n = g.number_of_verteces();
+
+        std::vector<size_t> offsets(n + 1, 0);
+        for (size_t i = 0; i < n; ++i)
+            offsets[i + 1] = offsets[i] + g.adjacent(i).size();
+
+        std::vector<V> targets;
+        targets.reserve(offsets.back());
+        std::vector<W> weights;
+        if (g.is_weighted())
+            weights.reserve(offsets.back());
+
+        for (size_t i = 0; i < n; ++i) {
+            for (const auto &it : g.adjacent(i)) {
+                targets.push_back(static_cast<V>(edge_target(it)));
+                if (g.is_weighted())
+                    weights.push_back(static_cast<W>(edge_weight(it)));
+            }
+        }
+
+        return CSR_graph<V, W>(directed, std::move(offsets), std::move(targets), std::move(weights));
+    }
+
+    // id and weight types a frozen copy of entries of type N keeps unless the caller picks others;
+    // plain ids freeze to size_t
+    template<typename N, bool = is_weighted_node<N>::value>
+    struct frozen_types {
+        using vertex_type = size_t;
+        using weight_type = size_t;
+    };
+
+    template<typename N>
+    struct frozen_types<N, true> {
+        using vertex_type = typename N::vertex_type;
+        using weight_type = typename N::weight_type;
+    };
+
+    template<typename V, typename N>
+    using frozen_vertex_t = std::conditional_t<std::is_void<V>::value, typename frozen_types<N>::vertex_type, V>;
+
+    template<typename W, typename N>
+    using frozen_weight_t = std::conditional_t<std::is_void<W>::value, typename frozen_types<N>::weight_type, W>;
+
+    template<typename V = void, typename W = void, typename N>
+    CSR_graph<frozen_vertex_t<V, N>, frozen_weight_t<W, N>> freeze(const DirectedGraph<N> &g) {
+        return freeze_adjacency<frozen_vertex_t<V, N>, frozen_weight_t<W, N>>(g, true);
+    }
+
+    template<typename V = void, typename W = void, typename N>
+    CSR_graph<frozen_vertex_t<V, N>, frozen_weight_t<W, N>> freeze(const UndirectedGraph<N> &g) {
+        return freeze_adjacency<frozen_vertex_t<V, N>, frozen_weight_t<W, N>>(g, false);
+    }
+
+    template<typename N, typename V, typename W>
+    DirectedGraph<N> to_directed_graph(const CSR_graph<V, W> &g) {
+        size_t n = g.number_of_verteces();
+        DirectedGraph<N> result(n, g.is_weighted());
+
+        std::vector<N> list;
+        for (size_t i = 0; i < n; ++i) {
+            list.clear();
+            auto neighbours = g.adjacent(i);
+            for (size_t j = 0, end_ = neighbours.size(); j < end_; ++j)
+                list.push_back(make_node<N>(static_cast<size_t>(neighbours[j]),
+                                            g.is_weighted() ? g.adjacent_weights(i)[j] : W(1)));
+            if (!list.empty())
+                result.add_node(i, list.data(), list.size());
+        }
+
+        return result;
+    }
+
+    template<typename N, typename V, typename W>
+    UndirectedGraph<N> to_undirected_graph(const CSR_graph<V, W> &g) {
+        if (g.is_directed())
+            throw std::invalid_argument("directed graph");
+
+        size_t n = g.number_of_verteces();
+        UndirectedGraph<N> result(n, g.is_weighted());
+
+        std::vector<N> list;
+        for (size_t i = 0; i < n; ++i) {
+            list.clear();
+            bool loop_seen = false;        // a self loop is stored twice in its own list
+            auto neighbours = g.adjacent(i);
+            for (size_t j = 0, end_ = neighbours.size(); j < end_; ++j) {
+                auto next = static_cast<size_t>(neighbours[j]);
+                if (next < i || (next == i && (loop_seen = !loop_seen)))
+                    continue;
+
+                list.push_back(make_node<N>(next, g.is_weighted() ? g.adjacent_weights(i)[j] : W(1)));
+            }
+            if (!list.empty())
+                result.add_node(i, list.data(), list.size());
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#ifndef GRAPH_LCA_H
+#define GRAPH_LCA_H
+
+#endif //GRAPH_LCA_H
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../disjoint_set_union/flat_DSU.h"
+#include "graph.h"
+
+namespace graph {
+    static constexpr size_t no_ancestor = std::numeric_limits<size_t>::max();
+
+    // Tarjan's offline LCA. G is DirectedGraph (edges go from parents to children) or UndirectedGraph;
+    // queries with a vertex unreachable from root are answered with no_ancestor
+    template<typename G>
+    std::vector<size_t> tarjan_lca(const G &tree, size_t root, const std::vector<std::pair<size_t, size_t>> &queries) {
+        static_assert(is_graph<G>::value, "G must provide number_of_verteces() and adjacent()");
+
+        size_t n = tree.number_of_verteces();
+        if (root >= n)
+            throw std::invalid_argument("invalid vertex");
+        if (n > Flat_DSU<>::max_size)
+            throw std::length_error("tree");
+
+        std::vector<size_t> query_offsets(n + 1, 0);
+        for (const auto &it : queries) {
+            if (it.first >= n || it.second >= n)
+                throw std::invalid_argument("invalid vertices");
+
+            ++query_offsets[it.first + 1];
+            ++query_offsets[it.second + 1];
+        }
+        for (size_t i = 0; i < n; ++i)
+            query_offsets[i + 1] += query_offsets[i];
+
+        std::vector<std::pair<size_t, size_t>> query_list(2 * queries.size());      // other vertex and query index
+        {
+            std::vector<size_t> cursor(query_offsets.begin(), query_offsets.end() - 1);
+            for (size_t i = 0; i < queries.size(); ++i) {
+                query_list[cursor[queries[i].first]++] = std::make_pair(queries[i].second, i);
+                query_list[cursor[queries[i].second]++] = std::make_pair(queries[i].first, i);
+            }
+        }
+
+        std::vector<size_t> result(queries.size(), no_ancestor);
+        Flat_DSU<> dsu(n);
+        std::vector<uint32_t> ancestor(n);
+        std::vector<size_t> parent(n, no_ancestor);
+        std::vector<bool> visited(n, false);
+        std::vector<bool> finished(n, false);
+
+        std::vector<std::pair<size_t, size_t>> stack;       // vertex and next neighbour to look at
+        stack.emplace_back(root, 0);
+        visited[root] = true;
+        ancestor[root] = static_cast<uint32_t>(root);
+
+        while (!stack.empty()) {
+            auto &top = stack.back();
+            auto vertex = top.first;
+            const auto &neighbours = tree.adjacent(vertex);
+
+            if (top.second < neighbours.size()) {
+                auto next = static_cast<size_t>(neighbours[top.second++]);
+                if (!visited[next]) {
+                    visited[next] = true;
+                    ancestor[next] = static_cast<uint32_t>(next);
+                    parent[next] = vertex;
+                    stack.emplace_back(next, 0);
+                }
+
+                continue;
+            }
+
+            stack.pop_back();
+            finished[vertex] = true;
+            for (size_t i = query_offsets[vertex]; i < query_offsets[vertex + 1]; ++i) {
+                auto other = query_list[i].first;
+                if (finished[other])
+                    result[query_list[i].second] = ancestor[dsu.find(static_cast<uint32_t>(other))];
+            }
+
+            if (parent[vertex] != no_ancestor) {
+                auto united = dsu.unite(static_cast<uint32_t>(parent[vertex]), static_cast<uint32_t>(vertex));
+                ancestor[united] = static_cast<uint32_t>(parent[vertex]);
+            }
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,259 @@
+#pragma once
+
+#ifndef GRAPH_SSSP_H
+#define GRAPH_SSSP_H
+
+#endif //GRAPH_SSSP_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CSR_graph.h"
+#include "parallel.h"
+
+namespace graph {
+    template<typename W>
+    using distance_type = std::conditional_t<std::is_floating_point<W>::value, double, uint64_t>;
+
+    template<typename W>
+    constexpr distance_type<W> infinite_distance() {
+        return std::numeric_limits<distance_type<W>>::max();
+    }
+
+    template<typename G>
+    typename G::weight_type csr_weight(const G &g, size_t vertex, size_t index) {      // unweighted edges weigh 1
+        return g.is_weighted() ? g.adjacent_weights(vertex)[index] : typename G::weight_type(1);
+    }
+
+    template<typename G>
+    using csr_distance_t = distance_type<typename G::weight_type>;
+
+    // sequential baseline for validation
+    template<typename G, typename = enable_if_csr_graph_t<G>>
+    std::vector<csr_distance_t<G>> dijkstra(const G &g, size_t source) {
+        using W = typename G::weight_type;
+        using D = distance_type<W>;
+
+        size_t n = g.number_of_verteces();
+        if (source >= n)
+            throw std::invalid_argument("invalid vertex");
+
+        std::vector<D> result(n, infinite_distance<W>());
+        std::priority_queue<std::pair<D, size_t>, std::vector<std::pair<D, size_t>>, std::greater<>> heap;
+        result[source] = 0;
+        heap.emplace(0, source);
+
+        while (!heap.empty()) {
+            auto top = heap.top();
+            heap.pop();
+            if (top.first != result[top.second])
+                continue;
+
+            auto neighbours = g.adjacent(top.second);
+            for (size_t i = 0, end_ = neighbours.size(); i < end_; ++i) {
+                auto next = static_cast<size_t>(neighbours[i]);
+                D candidate = top.first + static_cast<D>(csr_weight(g, top.second, i));
+                if (candidate < result[next]) {
+                    result[next] = candidate;
+                    heap.emplace(candidate, next);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    // Meyer-Sanders: delta of about max weight / average degree keeps both the number of phases
+    // and the reinsertions per phase small
+    template<typename G>
+    typename G::weight_type max_edge_weight(const G &g) {      // 1 for unweighted graphs
+        using W = typename G::weight_type;
+
+        W result = W(1);
+        bool first = true;
+        for (size_t i = 0, end_ = g.is_weighted() ? g.number_of_verteces() : 0; i < end_; ++i) {
+            for (const auto &it : g.adjacent_weights(i)) {
+                result = first ? it : std::max(result, it);
+                first = false;
+            }
+        }
+
+        return result;
+    }
+
+    template<typename G, typename = enable_if_csr_graph_t<G>>
+    csr_distance_t<G> tune_delta(const G &g) {
+        using W = typename G::weight_type;
+        using D = distance_type<W>;
+
+        size_t entries = 0;
+        W max_weight = W();
+        W min_weight = W();
+        for (size_t i = 0, end_ = g.number_of_verteces(); i < end_; ++i) {
+            for (const auto &it : g.adjacent_weights(i)) {
+                max_weight = entries ? std::max(max_weight, it) : it;
+                min_weight = entries ? std::min(min_weight, it) : it;
+                ++entries;
+            }
+        }
+        if (!g.is_weighted() || !entries)
+            return D(1);
+
+        D average_degree = std::max<D>(D(1), static_cast<D>(entries / std::max<size_t>(1, g.number_of_verteces())));
+
+        D result = std::max(static_cast<D>(max_weight) / average_degree, static_cast<D>(min_weight));
+        if (std::is_integral<D>::value)     // integer distances: a narrower bucket could never hold two of them
+            result = std::max(result, D(1));
+
+        return result > 0 ? result : D(1);      // every weight is zero
+    }
+
+    template<typename G, typename = enable_if_csr_graph_t<G>>
+    std::vector<csr_distance_t<G>> delta_stepping(const G &g, size_t source, csr_distance_t<G> delta = 0,
+                                                  size_t threads = default_threads()) {
+        using W = typename G::weight_type;
+        using D = distance_type<W>;
+
+        size_t n = g.number_of_verteces();
+        if (source >= n)
+            throw std::invalid_argument("invalid vertex");
+        if (!(delta > 0))
+            delta = tune_delta(g);
+        if (!threads)
+            threads = 1;
+
+        std::unique_ptr<std::atomic<D>[]> distances(new std::atomic<D>[n]);
+        for (size_t i = 0; i < n; ++i)
+            distances[i].store(infinite_distance<W>(), std::memory_order_relaxed);
+        distances[source].store(0, std::memory_order_relaxed);
+
+        auto bucket_of = [delta](D distance) {
+            return static_cast<size_t>(distance / delta);
+        };
+
+        // a relaxation from bucket i lands at most max weight / delta + 1 buckets further, so that many slots
+        // used cyclically hold every pending bucket
+        auto max_weight = static_cast<D>(max_edge_weight(g));
+        if (static_cast<double>(max_weight) / static_cast<double>(delta) > static_cast<double>(uint32_t(-1)))
+            throw std::invalid_argument("delta");
+        size_t slots = bucket_of(max_weight) + 2;
+
+        std::vector<std::vector<size_t>> buckets(slots);
+        buckets[0].push_back(source);
+        size_t pending = 1;         // entries over all slots, stale ones included
+        std::vector<std::vector<std::vector<size_t>>> local_buckets(threads, std::vector<std::vector<size_t>>(slots));      // thread-local insertions, merged after each step
+        std::vector<std::vector<size_t>> touched(threads);
+
+        auto relax = [&](size_t thread, size_t vertex, D candidate) {
+            auto current = distances[vertex].load(std::memory_order_relaxed);
+            while (candidate < current) {
+                if (distances[vertex].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                    auto slot = bucket_of(candidate) % slots;
+                    auto &local = local_buckets[thread];
+                    if (local[slot].empty())
+                        touched[thread].push_back(slot);
+                    local[slot].push_back(vertex);
+                    break;
+                }
+            }
+        };
+
+        auto merge_local = [&]() {
+            for (size_t t = 0; t < threads; ++t) {
+                for (auto slot : touched[t]) {
+                    auto &local = local_buckets[t][slot];
+                    buckets[slot].insert(buckets[slot].end(), local.begin(), local.end());
+                    pending += local.size();
+                    local.clear();
+                }
+                touched[t].clear();
+            }
+        };
+
+        auto relax_edges = [&](const std::vector<size_t> &vertices, bool light) {
+            parallel_for(0, vertices.size(), threads, 64, [&](size_t thread, size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    auto vertex = vertices[i];
+                    auto distance = distances[vertex].load(std::memory_order_relaxed);
+                    auto neighbours = g.adjacent(vertex);
+                    for (size_t j = 0, end_ = neighbours.size(); j < end_; ++j) {
+                        D weight = static_cast<D>(csr_weight(g, vertex, j));
+                        if ((weight <= delta) == light)
+                            relax(thread, static_cast<size_t>(neighbours[j]), distance + weight);
+                    }
+                }
+            });
+        };
+
+        std::vector<size_t> marks(n, 0);        // bucket index + 1 of the phase that settled the vertex
+        std::vector<size_t> settled;
+        std::vector<size_t> frontier;
+        for (size_t current = 0; pending; ++current) {
+            auto &bucket = buckets[current % slots];
+            if (bucket.empty())
+                continue;
+
+            settled.clear();
+            while (!bucket.empty()) {
+                frontier.clear();
+                pending -= bucket.size();
+                for (auto it : bucket) {
+                    if (bucket_of(distances[it].load(std::memory_order_relaxed)) != current)
+                        continue;
+
+                    frontier.push_back(it);
+                    if (marks[it] != current + 1) {
+                        marks[it] = current + 1;
+                        settled.push_back(it);
+                    }
+                }
+                bucket.clear();
+
+                relax_edges(frontier, true);
+                merge_local();
+            }
+
+            relax_edges(settled, false);
+            merge_local();
+        }
+
+        std::vector<D> result(n);
+        for (size_t i = 0; i < n; ++i)
+            result[i] = distances[i].load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    template<typename N>
+    decltype(auto) dijkstra(const DirectedGraph<N> &g, size_t source) {
+        return dijkstra(freeze(g), source);
+    }
+
+    template<typename N>
+    decltype(auto) dijkstra(const UndirectedGraph<N> &g, size_t source) {
+        return dijkstra(freeze(g), source);
+    }
+
+    template<typename N>
+    decltype(auto) delta_stepping(const DirectedGraph<N> &g, size_t source,
+                                  distance_type<typename frozen_types<N>::weight_type> delta = 0,
+                                  size_t threads = default_threads()) {
+        return delta_stepping(freeze(g), source, delta, threads);
+    }
+
+    template<typename N>
+    decltype(auto) delta_stepping(const UndirectedGraph<N> &g, size_t source,
+                                  distance_type<typename frozen_types<N>::weight_type> delta = 0,
+                                  size_t threads = default_threads()) {
+        return delta_stepping(freeze(g), source, delta, threads);
+    }
+}
@@ -0,0 +1,362 @@
+#pragma once
+
+#ifndef GRAPH_COMPRESSED_GRAPH_H
+#define GRAPH_COMPRESSED_GRAPH_H
+
+#endif //GRAPH_COMPRESSED_GRAPH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "CSR_graph.h"
+#include "parallel.h"
+
+namespace graph {
+    inline size_t varint_size(uint64_t value) {
+        size_t result = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            ++result;
+        }
+
+        return result;
+    }
+
+    inline uint8_t *encode_varint(uint64_t value, uint8_t *out) {      // LEB128, seven bits per byte
+        while (value >= 0x80) {
+            *out++ = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        *out++ = static_cast<uint8_t>(value);
+
+        return out;
+    }
+
+    inline const uint8_t *decode_varint(const uint8_t *in, uint64_t &value) {
+        if (*in < 0x80) {       // most gaps of a well ordered graph fit into one byte
+            value = *in;
+            return in + 1;
+        }
+
+        value = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            uint64_t byte = *in++;
+            value |= (byte & 0x7F) << shift;
+            if (byte < 0x80)
+                return in;
+        }
+    }
+
+    inline uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    inline int64_t unzigzag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    // walks the encoded neighbours of one vertex from the start of a block; each block restarts relative
+    // to the vertex id
+    class Compressed_iterator final {
+        const uint8_t *position;
+        size_t vertex;
+        size_t index;
+        size_t last;
+        size_t value;
+        size_t block_size;
+        size_t block_left;
+
+        void decode() {
+            uint64_t code;
+            position = decode_varint(position, code);
+            if (!block_left) {
+                value = static_cast<size_t>(static_cast<int64_t>(vertex) + unzigzag(code));
+                block_left = block_size;
+            } else {
+                value += static_cast<size_t>(code);
+            }
+            --block_left;
+        };
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const size_t *;
+        using reference = const size_t &;
+
+        Compressed_iterator(const uint8_t *new_position_, size_t new_vertex_, size_t new_index_, size_t new_last_,
+                            size_t new_block_size_) : position(new_position_), vertex(new_vertex_), index(new_index_),
+                                                      last(new_last_), value(0), block_size(new_block_size_),
+                                                      block_left(0) {
+            if (index < last)
+                decode();
+        };
+
+        const size_t &operator*() const {
+            return value;
+        };
+
+        Compressed_iterator &operator++() {
+            if (++index < last)
+                decode();
+
+            return *this;
+        };
+
+        Compressed_iterator operator++(int) {
+            auto result = *this;
+            ++*this;
+            return result;
+        };
+
+        friend bool operator==(const Compressed_iterator &lhs, const Compressed_iterator &rhs) {
+            return lhs.index == rhs.index;
+        };
+
+        friend bool operator!=(const Compressed_iterator &lhs, const Compressed_iterator &rhs) {
+            return lhs.index != rhs.index;
+        };
+    };
+
+    class Compressed_range final {
+        Compressed_iterator first;
+        Compressed_iterator last;
+        size_t sz;
+
+    public:
+        Compressed_range(Compressed_iterator new_first_, Compressed_iterator new_last_, size_t new_sz_) :
+                first(new_first_), last(new_last_), sz(new_sz_) {};
+
+        Compressed_iterator begin() const {
+            return first;
+        };
+
+        Compressed_iterator end() const {
+            return last;
+        };
+
+        size_t size() const {
+            return sz;
+        };
+
+        bool empty() const {
+            return !sz;
+        };
+    };
+
+    // sorted adjacency lists stored as varint gaps in blocks of block_size neighbours; the first neighbour of
+    // every block is a zigzag delta from the vertex id, so blocks of one hub decode independently.
+    // A vertex record is its varint degree, then for lists of several blocks a 32-bit offset of every
+    // block after the first, relative to the record, then the blocks
+    template<typename W = size_t>
+    class Compressed_graph final {
+        bool directed;
+        size_t edges;
+        std::vector<uint64_t> records;              // byte position of every vertex record
+        std::vector<uint8_t> bytes;
+        std::vector<uint64_t> weight_offsets;       // weighted graphs only
+        std::vector<W> weights;                     // in sorted neighbour order
+
+        static size_t blocks_for(size_t degree) {
+            return (degree + block_size - 1) / block_size;
+        };
+
+        static size_t table_size(size_t degree) {
+            return degree > block_size ? (blocks_for(degree) - 1) * sizeof(uint32_t) : 0;
+        };
+
+        const uint8_t *record(size_t vertex, size_t &degree) const {       // returns the first byte after the degree
+            uint64_t code;
+            auto result = decode_varint(bytes.data() + records[vertex], code);
+            degree = static_cast<size_t>(code);
+
+            return result;
+        };
+
+        const uint8_t *block_start(size_t vertex, size_t block) const {
+            size_t degree;
+            auto table = record(vertex, degree);
+            if (!block)
+                return table + table_size(degree);
+
+            uint32_t offset;
+            std::memcpy(&offset, table + (block - 1) * sizeof(uint32_t), sizeof(uint32_t));
+            return bytes.data() + records[vertex] + offset;
+        };
+
+    public:
+        using weight_type = W;
+
+        static constexpr size_t block_size = 64;
+
+        Compressed_graph() : directed(true), edges(0), records(1, 0) {};
+
+        template<typename V>
+        explicit Compressed_graph(const CSR_graph<V, W> &g, size_t threads = default_threads());
+
+        size_t number_of_verteces() const {
+            return records.size() - 1;
+        };
+
+        size_t number_of_edges() const {
+            return edges;
+        };
+
+        bool empty() const {
+            return records.size() == 1;
+        };
+
+        bool is_weighted() const {
+            return !weights.empty();
+        };
+
+        bool is_directed() const {
+            return directed;
+        };
+
+        size_t degree(size_t vertex) const {
+            size_t result;
+            record(vertex, result);
+
+            return result;
+        };
+
+        size_t compressed_bytes() const {       // encoded records plus their index, weights excluded
+            return bytes.size() + records.size() * sizeof(uint64_t);
+        };
+
+        Compressed_range adjacent(size_t vertex) const {
+            size_t sz;
+            auto first = record(vertex, sz) + table_size(sz);
+            return Compressed_range(Compressed_iterator(first, vertex, 0, sz, block_size),
+                                    Compressed_iterator(nullptr, vertex, sz, sz, block_size), sz);
+        };
+
+        Adjacency_range<W> adjacent_weights(size_t vertex) const {     // empty range for unweighted graphs
+            if (weights.empty())
+                return Adjacency_range<W>(nullptr, nullptr);
+
+            return Adjacency_range<W>(weights.data() + weight_offsets[vertex], weights.data() + weight_offsets[vertex + 1]);
+        };
+
+        size_t blocks(size_t vertex) const {
+            return blocks_for(degree(vertex));
+        };
+
+        // f(neighbour, position in the list) for one block, lets several threads share a high-degree vertex
+        template<typename F>
+        void for_each_in_block(size_t vertex, size_t block, F f) const {
+            auto lo = block * block_size;
+            auto hi = std::min(degree(vertex), lo + block_size);
+            Compressed_iterator it(block_start(vertex, block), vertex, lo, hi, block_size);
+            for (auto i = lo; i < hi; ++i, ++it)
+                f(*it, i);
+        };
+
+        template<typename F>
+        void for_each_neighbour(size_t vertex, F f) const {
+            size_t i = 0;
+            for (auto it : adjacent(vertex))
+                f(it, i++);
+        };
+
+        template<typename V = size_t>
+        CSR_graph<V, W> decompress() const;
+    };
+
+    template<typename W>
+    template<typename V>
+    Compressed_graph<W>::Compressed_graph(const CSR_graph<V, W> &g, size_t threads) : directed(g.is_directed()),
+                                                                                     edges(g.number_of_edges()) {
+        size_t n = g.number_of_verteces();
+        if (g.is_weighted()) {
+            weight_offsets.assign(g.get_offsets().begin(), g.get_offsets().end());
+            weights.resize(g.get_targets().size());
+        }
+
+        // sorts every list (weights follow their edges)
+        auto sorted_list = [&](size_t vertex, std::vector<std::pair<V, W>> &list) {
+            auto neighbours = g.adjacent(vertex);
+            list.clear();
+            for (size_t j = 0, end_ = neighbours.size(); j < end_; ++j)
+                list.emplace_back(neighbours[j], g.is_weighted() ? g.adjacent_weights(vertex)[j] : W());
+            std::sort(list.begin(), list.end(), [](const std::pair<V, W> &lhs, const std::pair<V, W> &rhs) {
+                return lhs.first < rhs.first;
+            });
+        };
+        auto code = [](size_t vertex, size_t index, size_t current, size_t previous) -> uint64_t {
+            if (index % block_size == 0)
+                return zigzag(static_cast<int64_t>(current) - static_cast<int64_t>(vertex));
+
+            return current - previous;
+        };
+
+        // the size of every record, then their positions
+        records.assign(n + 1, 0);
+        parallel_for(0, n, threads, 1024, [&](size_t, size_t lo, size_t hi) {
+            std::vector<std::pair<V, W>> list;
+            for (size_t i = lo; i < hi; ++i) {
+                sorted_list(i, list);
+                size_t sz = varint_size(list.size()) + table_size(list.size());
+                for (size_t j = 0, end_ = list.size(); j < end_; ++j) {
+                    auto current = static_cast<size_t>(list[j].first);
+                    auto previous = j ? static_cast<size_t>(list[j - 1].first) : 0;
+                    sz += varint_size(code(i, j, current, previous));
+                }
+                if (sz > std::numeric_limits<uint32_t>::max())
+                    throw std::length_error("adjacency list");
+
+                records[i + 1] = sz;
+            }
+        });
+        parallel_prefix_sum(records, threads);
+
+        bytes.resize(records.back());
+        parallel_for(0, n, threads, 1024, [&](size_t, size_t lo, size_t hi) {
+            std::vector<std::pair<V, W>> list;
+            for (size_t i = lo; i < hi; ++i) {
+                sorted_list(i, list);
+                auto start = bytes.data() + records[i];
+                auto table = encode_varint(list.size(), start);
+                auto out = table + table_size(list.size());
+                for (size_t j = 0, end_ = list.size(); j < end_; ++j) {
+                    if (j && j % block_size == 0) {
+                        auto offset = static_cast<uint32_t>(out - start);
+                        std::memcpy(table + (j / block_size - 1) * sizeof(uint32_t), &offset, sizeof(uint32_t));
+                    }
+
+                    auto current = static_cast<size_t>(list[j].first);
+                    auto previous = j ? static_cast<size_t>(list[j - 1].first) : 0;
+                    out = encode_varint(code(i, j, current, previous), out);
+                    if (!weights.empty())
+                        weights[weight_offsets[i] + j] = list[j].second;
+                }
+            }
+        });
+    }
+
+    template<typename W>
+    template<typename V>
+    CSR_graph<V, W> Compressed_graph<W>::decompress() const {
+        size_t n = number_of_verteces();
+        std::vector<size_t> offsets(n + 1, 0);
+        for (size_t i = 0; i < n; ++i)
+            offsets[i + 1] = offsets[i] + degree(i);
+
+        std::vector<V> targets(offsets.back());
+        for (size_t i = 0; i < n; ++i) {
+            auto position = offsets[i];
+            for (auto it : adjacent(i))
+                targets[position++] = static_cast<V>(it);
+        }
+
+        return CSR_graph<V, W>(directed, std::move(offsets), std::move(targets), std::vector<W>(weights));
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#ifndef GRAPH_CONNECTED_COMPONENTS_H
+#define GRAPH_CONNECTED_COMPONENTS_H
+
+#endif //GRAPH_CONNECTED_COMPONENTS_H
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "CSR_graph.h"
+#include "parallel.h"
+
+namespace graph {
+    struct Components_result {
+        std::vector<size_t> labels;     // smallest vertex of the component
+        size_t components;
+    };
+
+    // hooks the larger of two roots under the smaller one, retrying when another thread got there first
+    template<typename V>
+    void link_components(std::atomic<V> *labels, size_t first, size_t last) {
+        auto lparent = static_cast<size_t>(labels[first].load(std::memory_order_relaxed));
+        auto rparent = static_cast<size_t>(labels[last].load(std::memory_order_relaxed));
+        while (lparent != rparent) {
+            auto high = std::max(lparent, rparent);
+            auto low = std::min(lparent, rparent);
+            auto high_parent = labels[high].load(std::memory_order_relaxed);
+            if (static_cast<size_t>(high_parent) == low)
+                break;
+
+            auto expected = static_cast<V>(high);
+            if (static_cast<size_t>(high_parent) == high &&
+                labels[high].compare_exchange_strong(expected, static_cast<V>(low), std::memory_order_relaxed))
+                break;
+
+            lparent = static_cast<size_t>(labels[static_cast<size_t>(labels[high].load(std::memory_order_relaxed))].load(std::memory_order_relaxed));
+            rparent = static_cast<size_t>(labels[low].load(std::memory_order_relaxed));
+        }
+    }
+
+    template<typename V>
+    void compress_components(std::atomic<V> *labels, size_t n, size_t threads) {
+        parallel_for(0, n, threads, 4096, [&](size_t, size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                auto parent = labels[i].load(std::memory_order_relaxed);
+                auto grandparent = labels[static_cast<size_t>(parent)].load(std::memory_order_relaxed);
+                while (parent != grandparent) {
+                    labels[i].store(grandparent, std::memory_order_relaxed);
+                    parent = grandparent;
+                    grandparent = labels[static_cast<size_t>(parent)].load(std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    // Afforest (Sutton et al.): linking a few sampled neighbours per vertex already joins the giant component,
+    // so the remaining edges only have to be scanned from vertices outside of it
+    template<typename G, typename = enable_if_csr_graph_t<G>>
+    Components_result connected_components(const G &g, size_t threads = default_threads()) {
+        using V = typename G::vertex_type;
+
+        constexpr size_t neighbour_rounds = 2;
+        constexpr size_t samples = 1024;
+
+        if (g.is_directed())
+            throw std::invalid_argument("directed graph");
+        if (!threads)
+            threads = 1;
+
+        size_t n = g.number_of_verteces();
+        std::unique_ptr<std::atomic<V>[]> labels(new std::atomic<V>[n]);
+        for (size_t i = 0; i < n; ++i)
+            labels[i].store(static_cast<V>(i), std::memory_order_relaxed);
+
+        for (size_t round = 0; round < neighbour_rounds; ++round) {
+            parallel_for(0, n, threads, 4096, [&](size_t, size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    auto neighbours = g.adjacent(i);
+                    if (round < neighbours.size())
+                        link_components(labels.get(), i, static_cast<size_t>(neighbours[round]));
+                }
+            });
+            compress_components(labels.get(), n, threads);
+        }
+
+        size_t frequent = n;
+        if (n) {
+            std::mt19937_64 generator(n);
+            std::uniform_int_distribution<size_t> distribution(0, n - 1);
+            std::unordered_map<size_t, size_t> counts;
+            size_t best = 0;
+            for (size_t i = 0; i < samples; ++i) {
+                auto label = static_cast<size_t>(labels[distribution(generator)].load(std::memory_order_relaxed));
+                if (++counts[label] > best) {
+                    best = counts[label];
+                    frequent = label;
+                }
+            }
+        }
+
+        parallel_for(0, n, threads, 1024, [&](size_t, size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                if (static_cast<size_t>(labels[i].load(std::memory_order_relaxed)) == frequent)
+                    continue;
+
+                auto neighbours = g.adjacent(i);
+                for (size_t j = neighbour_rounds, end_ = neighbours.size(); j < end_; ++j)
+                    link_components(labels.get(), i, static_cast<size_t>(neighbours[j]));
+            }
+        });
+        compress_components(labels.get(), n, threads);
+
+        Components_result result;
+        result.labels.resize(n);
+        result.components = 0;
+        for (size_t i = 0; i < n; ++i) {
+            result.labels[i] = static_cast<size_t>(labels[i].load(std::memory_order_relaxed));
+            if (result.labels[i] == i)
+                ++result.components;
+        }
+
+        return result;
+    }
+
+    template<typename N>
+    Components_result connected_components(const UndirectedGraph<N> &g, size_t threads = default_threads()) {
+        return connected_components(freeze(g), threads);
+    }
+}
@@ -0,0 +1,408 @@
+#pragma once
+
+#ifndef GRAPH_DYNAMIC_GRAPH_H
+#define GRAPH_DYNAMIC_GRAPH_H
+
+#endif //GRAPH_DYNAMIC_GRAPH_H
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "CSR_graph.h"
+#include "graph.h"
+
+namespace graph {
+    template<typename N>
+    N twin_node(const N &node, size_t number) {      // the reverse entry keeps the weight
+        return make_node<N>(number, edge_weight(node));
+    }
+
+    // every entry knows the position of its twin in the other end's list, so an edge is unlinked
+    // from both ends by swapping with the last entry
+    template<typename N>
+    class DynamicUndirectedGraph final : public Graph_base<DynamicUndirectedGraph<N>, N> {
+        friend class Graph_base<DynamicUndirectedGraph<N>, N>;
+
+        size_t edges;
+        bool weighted;
+        std::vector<std::vector<N>> adj_list;
+        std::vector<std::vector<size_t>> twins;
+
+        void do_reserve(size_t cap) {
+            adj_list.reserve(cap);
+            twins.reserve(cap);
+        };
+
+        size_t get_number_of_verteces() const {
+            return adj_list.size();
+        };
+
+        size_t get_number_of_edges() const {
+            return edges;
+        };
+
+        bool is_empty() const {
+            return adj_list.empty();
+        };
+
+        bool check_if_weighted() const {
+            return weighted;
+        };
+
+        void do_add_node(size_t number, N *begin, size_t sz);
+
+        void do_remove_edge(size_t first, const N &last);
+
+        void do_remove_edge(size_t first);
+
+        void link(size_t first, const N &last);
+
+        void erase_slot(size_t vertex, size_t index);
+
+    public:
+        using Graph_base<DynamicUndirectedGraph<N>, N>::add_node;
+
+        DynamicUndirectedGraph() : Graph_base<DynamicUndirectedGraph<N>, N>(), edges(0), weighted(false) {};
+
+        DynamicUndirectedGraph(size_t sz, bool w) : Graph_base<DynamicUndirectedGraph<N>, N>(), edges(0), weighted(w),
+                                                    adj_list(sz), twins(sz) {};
+
+        template<typename INIt>
+        void add_node(size_t number, INIt begin, INIt end);
+
+        void remove_edge_at(size_t vertex, size_t index);
+
+        const std::vector<N> &adjacent(size_t vertex) const {
+            if (vertex >= adj_list.size())
+                throw std::invalid_argument("invalid vertex");
+
+            return adj_list[vertex];
+        };
+
+        size_t degree(size_t vertex) const {
+            return adjacent(vertex).size();
+        };
+
+        template<typename T>
+        friend std::ostream &operator<<(std::ostream &os, const DynamicUndirectedGraph<T> &g);
+
+        ~DynamicUndirectedGraph() = default;
+    };
+
+    template<typename N>
+    std::ostream &operator<<(std::ostream &os, const DynamicUndirectedGraph<N> &g) {
+        for (size_t i = 0, end_ = g.number_of_verteces(); i < end_; ++i) {
+            if (i)
+                os << std::endl;
+            os << i << ": ";
+            for (const auto &it : g.adj_list[i])
+                os << it << " ";
+        }
+
+        return os;
+    }
+
+    template<typename N>
+    void DynamicUndirectedGraph<N>::link(size_t first, const N &last) {
+        auto second = static_cast<size_t>(last);
+        if (second >= this->number_of_verteces())
+            throw std::invalid_argument("invalid vertices");
+
+        auto index = adj_list[first].size();
+        auto twin_index = first == second ? index + 1 : adj_list[second].size();
+
+        adj_list[first].push_back(last);
+        twins[first].push_back(twin_index);
+        adj_list[second].push_back(twin_node(last, first));
+        twins[second].push_back(index);
+        ++edges;
+    }
+
+    template<typename N>
+    void DynamicUndirectedGraph<N>::erase_slot(size_t vertex, size_t index) {
+        auto &list = adj_list[vertex];
+        auto &list_twins = twins[vertex];
+        auto last = list.size() - 1;
+        if (index != last) {
+            list[index] = std::move(list[last]);
+            list_twins[index] = list_twins[last];
+            twins[static_cast<size_t>(list[index])][list_twins[index]] = index;
+        }
+
+        list.pop_back();
+        list_twins.pop_back();
+    }
+
+    template<typename N>
+    void DynamicUndirectedGraph<N>::remove_edge_at(size_t vertex, size_t index) {
+        if (vertex >= this->number_of_verteces() || index >= adj_list[vertex].size())
+            throw std::invalid_argument("invalid edge");
+
+        auto other = static_cast<size_t>(adj_list[vertex][index]);
+        auto twin_index = twins[vertex][index];
+        if (other == vertex && twin_index < index)      // both ends live in one list, the later slot goes first
+            std::swap(index, twin_index);
+
+        erase_slot(other, twin_index);
+        erase_slot(vertex, index);
+        --edges;
+    }
+
+    template<typename N>
+    template<typename INIt>
+    void DynamicUndirectedGraph<N>::add_node(size_t number, INIt begin, INIt end) {
+        if (number > this->number_of_verteces())
+            throw std::invalid_argument("vertex to add");
+
+        if (number == this->number_of_verteces()) {
+            adj_list.emplace_back();
+            twins.emplace_back();
+        }
+
+        for (auto it = begin; it != end; ++it)
+            link(number, *it);
+    }
+
+    template<typename N>
+    void DynamicUndirectedGraph<N>::do_add_node(size_t number, N *begin, size_t sz) {
+        if (!begin)
+            throw std::invalid_argument("list of nodes");
+
+        add_node(number, begin, begin + sz);
+    }
+
+    template<typename N>
+    void DynamicUndirectedGraph<N>::do_remove_edge(size_t first, const N &last) {
+        if (first >= this->number_of_verteces() ||
+            last >= this->number_of_verteces())      // N type must implement comparison with size_t type
+            throw std::invalid_argument("invalid vertices");
+
+        const auto &list = adj_list[first];
+        auto node = std::find(list.begin(), list.end(), last);
+        if (node != list.end())
+            remove_edge_at(first, node - list.begin());
+    }
+
+    template<typename N>
+    void DynamicUndirectedGraph<N>::do_remove_edge(size_t first) {     // O(degree)
+        if (first >= this->number_of_verteces())
+            throw std::invalid_argument("invalid vertex");
+
+        while (!adj_list[first].empty())
+            remove_edge_at(first, adj_list[first].size() - 1);
+    }
+
+    // out-lists carry the positions of their entries in the targets' in-lists and vice versa
+    template<typename N>
+    class DynamicDirectedGraph final : public Graph_base<DynamicDirectedGraph<N>, N> {
+        friend class Graph_base<DynamicDirectedGraph<N>, N>;
+
+        size_t edges;
+        bool weighted;
+        std::vector<std::vector<N>> adj_list;
+        std::vector<std::vector<size_t>> out_twins;
+        std::vector<std::vector<size_t>> reverse_list;
+        std::vector<std::vector<size_t>> in_twins;
+
+        void do_reserve(size_t cap) {
+            adj_list.reserve(cap);
+            out_twins.reserve(cap);
+            reverse_list.reserve(cap);
+            in_twins.reserve(cap);
+        };
+
+        size_t get_number_of_verteces() const {
+            return adj_list.size();
+        };
+
+        size_t get_number_of_edges() const {
+            return edges;
+        };
+
+        bool is_empty() const {
+            return adj_list.empty();
+        };
+
+        bool check_if_weighted() const {
+            return weighted;
+        };
+
+        void do_add_node(size_t number, N *begin, size_t sz);
+
+        void do_remove_edge(size_t first, const N &last);
+
+        void do_remove_edge(size_t first);
+
+        void link(size_t first, const N &last);
+
+    public:
+        using Graph_base<DynamicDirectedGraph<N>, N>::add_node;
+
+        DynamicDirectedGraph() : Graph_base<DynamicDirectedGraph<N>, N>(), edges(0), weighted(false) {};
+
+        DynamicDirectedGraph(size_t sz, bool w) : Graph_base<DynamicDirectedGraph<N>, N>(), edges(0), weighted(w),
+                                                  adj_list(sz), out_twins(sz), reverse_list(sz), in_twins(sz) {};
+
+        template<typename INIt>
+        void add_node(size_t number, INIt begin, INIt end);
+
+        void remove_edge_at(size_t vertex, size_t index);
+
+        void isolate(size_t vertex);        // drops outgoing and incoming edges in O(degree)
+
+        const std::vector<N> &adjacent(size_t vertex) const {
+            if (vertex >= adj_list.size())
+                throw std::invalid_argument("invalid vertex");
+
+            return adj_list[vertex];
+        };
+
+        const std::vector<size_t> &incoming(size_t vertex) const {
+            if (vertex >= reverse_list.size())
+                throw std::invalid_argument("invalid vertex");
+
+            return reverse_list[vertex];
+        };
+
+        size_t out_degree(size_t vertex) const {
+            return adjacent(vertex).size();
+        };
+
+        size_t in_degree(size_t vertex) const {
+            return incoming(vertex).size();
+        };
+
+        template<typename T>
+        friend std::ostream &operator<<(std::ostream &os, const DynamicDirectedGraph<T> &g);
+
+        ~DynamicDirectedGraph() = default;
+    };
+
+    template<typename N>
+    std::ostream &operator<<(std::ostream &os, const DynamicDirectedGraph<N> &g) {
+        for (size_t i = 0, end_ = g.number_of_verteces(); i < end_; ++i) {
+            if (i)
+                os << std::endl;
+            os << i << ": ";
+            for (const auto &it : g.adj_list[i])
+                os << it << " ";
+        }
+
+        return os;
+    }
+
+    template<typename N>
+    void DynamicDirectedGraph<N>::link(size_t first, const N &last) {
+        auto second = static_cast<size_t>(last);
+        if (second >= this->number_of_verteces())
+            throw std::invalid_argument("invalid vertices");
+
+        out_twins[first].push_back(reverse_list[second].size());
+        in_twins[second].push_back(adj_list[first].size());
+        adj_list[first].push_back(last);
+        reverse_list[second].push_back(first);
+        ++edges;
+    }
+
+    template<typename N>
+    void DynamicDirectedGraph<N>::remove_edge_at(size_t vertex, size_t index) {
+        if (vertex >= this->number_of_verteces() || index >= adj_list[vertex].size())
+            throw std::invalid_argument("invalid edge");
+
+        auto target = static_cast<size_t>(adj_list[vertex][index]);
+        auto twin_index = out_twins[vertex][index];
+
+        auto &sources = reverse_list[target];
+        auto &sources_twins = in_twins[target];
+        auto last = sources.size() - 1;
+        if (twin_index != last) {
+            sources[twin_index] = sources[last];
+            sources_twins[twin_index] = sources_twins[last];
+            out_twins[sources[twin_index]][sources_twins[twin_index]] = twin_index;
+        }
+        sources.pop_back();
+        sources_twins.pop_back();
+
+        auto &targets = adj_list[vertex];
+        auto &targets_twins = out_twins[vertex];
+        last = targets.size() - 1;
+        if (index != last) {
+            targets[index] = std::move(targets[last]);
+            targets_twins[index] = targets_twins[last];
+            in_twins[static_cast<size_t>(targets[index])][targets_twins[index]] = index;
+        }
+        targets.pop_back();
+        targets_twins.pop_back();
+
+        --edges;
+    }
+
+    template<typename N>
+    void DynamicDirectedGraph<N>::isolate(size_t vertex) {
+        do_remove_edge(vertex);
+
+        while (!reverse_list[vertex].empty()) {
+            auto last = reverse_list[vertex].size() - 1;
+            remove_edge_at(reverse_list[vertex][last], in_twins[vertex][last]);
+        }
+    }
+
+    template<typename N>
+    template<typename INIt>
+    void DynamicDirectedGraph<N>::add_node(size_t number, INIt begin, INIt end) {
+        if (number > this->number_of_verteces())
+            throw std::invalid_argument("vertex to add");
+
+        if (number == this->number_of_verteces()) {
+            adj_list.emplace_back();
+            out_twins.emplace_back();
+            reverse_list.emplace_back();
+            in_twins.emplace_back();
+        }
+
+        for (auto it = begin; it != end; ++it)
+            link(number, *it);
+    }
+
+    template<typename N>
+    void DynamicDirectedGraph<N>::do_add_node(size_t number, N *begin, size_t sz) {
+        if (!begin)
+            throw std::invalid_argument("list of nodes");
+
+        add_node(number, begin, begin + sz);
+    }
+
+    template<typename N>
+    void DynamicDirectedGraph<N>::do_remove_edge(size_t first, const N &last) {
+        if (first >= this->number_of_verteces() ||
+            last >= this->number_of_verteces())      // N type must implement comparison with size_t type
+            throw std::invalid_argument("invalid vertices");
+
+        const auto &list = adj_list[first];
+        auto node = std::find(list.begin(), list.end(), last);
+        if (node != list.end())
+            remove_edge_at(first, node - list.begin());
+    }
+
+    template<typename N>
+    void DynamicDirectedGraph<N>::do_remove_edge(size_t first) {
+        if (first >= this->number_of_verteces())
+            throw std::invalid_argument("invalid vertex");
+
+        while (!adj_list[first].empty())
+            remove_edge_at(first, adj_list[first].size() - 1);
+    }
+
+    template<typename V = void, typename W = void, typename N>
+    CSR_graph<frozen_vertex_t<V, N>, frozen_weight_t<W, N>> freeze(const DynamicDirectedGraph<N> &g) {
+        return freeze_adjacency<frozen_vertex_t<V, N>, frozen_weight_t<W, N>>(g, true);
+    }
+
+    template<typename V = void, typename W = void, typename N>
+    CSR_graph<frozen_vertex_t<V, N>, frozen_weight_t<W, N>> freeze(const DynamicUndirectedGraph<N> &g) {
+        return freeze_adjacency<frozen_vertex_t<V, N>, frozen_weight_t<W, N>>(g, false);
+    }
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#endif //GRAPH_GENERATORS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "CSR_graph.h"
+#include "graph.h"
+#include "parallel.h"
+#include "random_edges.h"
+
+namespace graph {
+    // number of vertices of a Kronecker graph with a k x k initiator
+    inline size_t kronecker_vertices(size_t initiator_size, size_t levels) {
+        auto k = static_cast<size_t>(std::llround(std::sqrt(static_cast<double>(initiator_size))));
+        if (k < 2 || k * k != initiator_size)
+            throw std::invalid_argument("initiator");
+
+        size_t result = 1;
+        for (size_t i = 0; i < levels; ++i) {
+            if (result > std::numeric_limits<uint32_t>::max() / k)
+                throw std::invalid_argument("levels");
+            result *= k;
+        }
+
+        return result;
+    }
+
+    // stochastic Kronecker graph: every edge descends levels times into a k x k initiator matrix of probabilities;
+    // self loops and duplicate edges are kept, as in the Graph500 generator
+    template<typename Sink>
+    void kronecker_edges(const std::vector<double> &initiator, size_t levels, size_t number_of_edges, uint64_t seed,
+                         Sink sink, size_t max_weight = 0, size_t threads = default_threads()) {
+        constexpr size_t chunk_edges = size_t(1) << 16;
+
+        kronecker_vertices(initiator.size(), levels);
+        auto k = static_cast<size_t>(std::llround(std::sqrt(static_cast<double>(initiator.size()))));
+
+        double sum = 0;
+        for (auto it : initiator) {
+            if (!(it >= 0))
+                throw std::invalid_argument("initiator");
+            sum += it;
+        }
+        if (!(sum > 0))
+            throw std::invalid_argument("initiator");
+
+        // cells are picked by comparing raw 64-bit draws against scaled cumulative probabilities
+        std::vector<uint64_t> thresholds(initiator.size() - 1);
+        double cumulative = 0;
+        for (size_t i = 0; i + 1 < initiator.size(); ++i) {
+            cumulative += initiator[i] / sum;
+            thresholds[i] = cumulative >= 1.0 ? std::numeric_limits<uint64_t>::max()
+                                              : static_cast<uint64_t>(std::ldexp(cumulative, 64));
+        }
+
+        size_t chunks = (number_of_edges + chunk_edges - 1) / chunk_edges;
+        emit_chunks(chunks, threads, [&](size_t chunk, std::vector<Generated_edge> &out) {
+            Stream_rng gen(seed, chunk);
+            std::uniform_int_distribution<size_t> weight_dis(1, max_weight ? max_weight : 1);
+
+            size_t lo = chunk * chunk_edges;
+            size_t hi = std::min(number_of_edges, lo + chunk_edges);
+            out.reserve(hi - lo);
+            for (size_t i = lo; i < hi; ++i) {
+                Generated_edge edge{0, 0, 1};
+                for (size_t level = 0; level < levels; ++level) {
+                    uint64_t draw = gen();
+                    size_t cell = 0;
+                    for (auto it : thresholds)      // branchless, the draws are unpredictable
+                        cell += draw >= it;
+
+                    edge.first = edge.first * k + cell / k;
+                    edge.last = edge.last * k + cell % k;
+                }
+                if (max_weight)
+                    edge.weight = weight_dis(gen);
+
+                out.push_back(edge);
+            }
+        }, sink);
+    }
+
+    // R-MAT is the 2 x 2 Kronecker case, the defaults are the Graph500 parameters
+    template<typename Sink>
+    void rmat_edges(size_t scale, size_t number_of_edges, uint64_t seed, Sink sink, double a = 0.57, double b = 0.19,
+                    double c = 0.19, size_t max_weight = 0, size_t threads = default_threads()) {
+        if (!(a >= 0 && b >= 0 && c >= 0 && a + b + c <= 1))
+            throw std::invalid_argument("probabilities");
+
+        kronecker_edges({a, b, c, std::max(0.0, 1 - a - b - c)}, scale, number_of_edges, seed, sink, max_weight, threads);
+    }
+
+    template<typename V = size_t, typename W = size_t>
+    CSR_graph<V, W> random_gnm_graph(size_t number_of_vertices, size_t number_of_edges, bool directed, uint64_t seed,
+                                     size_t max_weight = 0, size_t threads = default_threads()) {
+        CSR_builder<V, W> builder(number_of_vertices, directed, max_weight != 0);
+        builder.reserve(number_of_edges);
+        gnm_edges(number_of_vertices, number_of_edges, directed, seed, [&builder](size_t first, size_t last, size_t weight) {
+            builder.add_edge(first, last, static_cast<W>(weight));
+        }, max_weight, threads);
+
+        return builder.build();
+    }
+
+    template<typename V = size_t, typename W = size_t>
+    CSR_graph<V, W> random_kronecker_graph(const std::vector<double> &initiator, size_t levels, size_t number_of_edges,
+                                           bool directed, uint64_t seed, size_t max_weight = 0,
+                                           size_t threads = default_threads()) {
+        CSR_builder<V, W> builder(kronecker_vertices(initiator.size(), levels), directed, max_weight != 0);
+        builder.reserve(number_of_edges);
+        kronecker_edges(initiator, levels, number_of_edges, seed, [&builder](size_t first, size_t last, size_t weight) {
+            builder.add_edge(first, last, static_cast<W>(weight));
+        }, max_weight, threads);
+
+        return builder.build();
+    }
+
+    template<typename V = size_t, typename W = size_t>
+    CSR_graph<V, W> random_rmat_graph(size_t scale, size_t number_of_edges, bool directed, uint64_t seed, double a = 0.57,
+                                      double b = 0.19, double c = 0.19, size_t max_weight = 0,
+                                      size_t threads = default_threads()) {
+        if (!(a >= 0 && b >= 0 && c >= 0 && a + b + c <= 1))
+            throw std::invalid_argument("probabilities");
+
+        return random_kronecker_graph<V, W>({a, b, c, std::max(0.0, 1 - a - b - c)}, scale, number_of_edges, directed,
+                                            seed, max_weight, threads);
+    }
+
+    // seeded counterparts of generate_random_graph
+    template<typename N>
+    DirectedGraph<N> random_directed_graph(size_t number_of_vertices, size_t number_of_edges, uint64_t seed,
+                                           size_t max_weight = 0, size_t threads = default_threads()) {
+        DirectedGraph<N> result;
+        result.generate_random_graph(number_of_vertices, number_of_edges, max_weight, seed, threads);
+        return result;
+    }
+
+    template<typename N>
+    UndirectedGraph<N> random_undirected_graph(size_t number_of_vertices, size_t number_of_edges, uint64_t seed,
+                                               size_t threads = default_threads()) {
+        UndirectedGraph<N> result;
+        result.generate_random_graph(number_of_vertices, number_of_edges, seed, threads);
+        return result;
+    }
+}
@@ -10,56 +10,208 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-static size_t generate_optimal_number(const size_t &number_of_vertices, const size_t &number_of_edges) {
-    size_t tmp = number_of_edges / number_of_vertices;
-    if (tmp + 2 < number_of_vertices)
-        return tmp + 2;
-    else
-        return number_of_vertices / 2;
-}
+#include "random_edges.h"
 
 namespace graph {
-    struct Node final {
-        size_t number;
-        size_t weight;
+    // adjacency entry with a vertex id of type V and a weight of type W, e.g. Basic_node<uint32_t, uint16_t> takes
+    // 8 bytes instead of the 16 of Node; frozen graphs keep weights in an array of their own (CSR_graph)
+    template<typename V = size_t, typename W = size_t>
+    struct Basic_node final {
+        using vertex_type = V;
+        using weight_type = W;
+
+        V number;
+        W weight;
 
-        Node() : number(0), weight(0) {};
+        Basic_node() : number(0), weight(0) {};
 
-        explicit Node(const size_t &new_number_) : number(new_number_), weight(1) {};
+        explicit Basic_node(const V &new_number_) : number(new_number_), weight(1) {};
 
-        Node(const size_t &new_number_, const size_t &new_weight_) : number(new_number_), weight(new_weight_) {};
+        Basic_node(const V &new_number_, const W &new_weight_) : number(new_number_), weight(new_weight_) {};
 
-        explicit operator const size_t &() const { return number; };
+        template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+        explicit operator T() const { return static_cast<T>(number); };
     };
 
-    bool operator>=(const Node &lhs, const size_t &rhs) {
+    // same entry without padding, Packed_node<uint32_t, uint16_t> takes 6 bytes; members may be unaligned,
+    // so they are only read and written by value
+#pragma pack(push, 1)
+    template<typename V = size_t, typename W = size_t>
+    struct Packed_node final {
+        using vertex_type = V;
+        using weight_type = W;
+
+        V number;
+        W weight;
+
+        Packed_node() : number(0), weight(0) {};
+
+        explicit Packed_node(const V &new_number_) : number(new_number_), weight(1) {};
+
+        Packed_node(const V &new_number_, const W &new_weight_) : number(new_number_), weight(new_weight_) {};
+
+        template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+        explicit operator T() const { return static_cast<T>(number); };
+    };
+#pragma pack(pop)
+
+    using Node = Basic_node<size_t, size_t>;
+
+    template<typename N>
+    struct is_weighted_node : std::false_type {};
+
+    template<typename V, typename W>
+    struct is_weighted_node<Basic_node<V, W>> : std::true_type {};
+
+    template<typename V, typename W>
+    struct is_weighted_node<Packed_node<V, W>> : std::true_type {};
+
+    template<typename N>
+    using if_weighted_node = std::enable_if_t<is_weighted_node<N>::value, int>;
+
+    template<typename N>
+    using if_plain_node = std::enable_if_t<!is_weighted_node<N>::value, int>;
+
+    template<typename N, if_weighted_node<N> = 0>
+    bool operator>=(const N &lhs, const size_t &rhs) {
         return lhs.number >= rhs;
     }
 
-    bool operator==(const size_t &lhs, const Node &rhs) {
+    template<typename N, if_weighted_node<N> = 0>
+    bool operator==(const size_t &lhs, const N &rhs) {
         return lhs == rhs.number;
     }
 
-    bool operator==(const Node &lhs, const size_t &rhs) {
+    template<typename N, if_weighted_node<N> = 0>
+    bool operator==(const N &lhs, const size_t &rhs) {
         return lhs.number == rhs;
     }
 
-    bool operator==(const Node &lhs, const Node &rhs) {
+    template<typename N, if_weighted_node<N> = 0>
+    bool operator==(const N &lhs, const N &rhs) {
         return lhs.number == rhs.number && lhs.weight == rhs.weight;
     }
 
-    std::ostream &operator<<(std::ostream &os, const Node &node) {
-        os << "(" << node.number << ", " << node.weight << ")";
+    template<typename N, if_weighted_node<N> = 0>
+    std::ostream &operator<<(std::ostream &os, const N &node) {
+        os << "(" << +node.number << ", " << +node.weight << ")";       // + prints 8-bit fields as numbers
 
         return os;
     }
 
+    template<typename N, typename T, if_plain_node<N> = 0>
+    N make_node(size_t number, const T &) {
+        return static_cast<N>(number);
+    }
+
+    template<typename N, typename T, if_weighted_node<N> = 0>
+    N make_node(size_t number, const T &weight) {
+        return N(static_cast<typename N::vertex_type>(number), static_cast<typename N::weight_type>(weight));
+    }
+
+    template<typename N>
+    size_t edge_target(const N &node) {
+        return static_cast<size_t>(node);
+    }
+
+    template<typename N, if_weighted_node<N> = 0>
+    typename N::weight_type edge_weight(const N &node) {
+        return node.weight;
+    }
+
+    template<typename N, if_plain_node<N> = 0>
+    size_t edge_weight(const N &) {
+        return 1;
+    }
+
+    template<typename N, bool = is_weighted_node<N>::value>
+    struct node_vertex {
+        using type = N;
+    };
+
+    template<typename N>
+    struct node_vertex<N, true> {
+        using type = typename N::vertex_type;
+    };
+
+    // true when every id below number_of_vertices fits into the vertex type of N
+    template<typename N>
+    bool fits_vertices(size_t number_of_vertices) {
+        using V = typename node_vertex<N>::type;
+        return !number_of_vertices || number_of_vertices - 1 <= static_cast<uint64_t>(std::numeric_limits<V>::max());
+    }
+
+    // static interface: calls resolve at compile time to the concrete graph's do_* methods
+    template<typename Derived, typename N>
+    class Graph_base {
+    public:
+        using node_type = N;
+
+        void reserve(size_t cap) {
+            derived().do_reserve(cap);
+        };
+
+        size_t number_of_verteces() const {
+            return derived().get_number_of_verteces();
+        };
+
+        size_t number_of_edges() const {
+            return derived().get_number_of_edges();
+        };
+
+        bool empty() const {
+            return derived().is_empty();
+        };
+
+        bool is_weighted() const {
+            return derived().check_if_weighted();
+        };
+
+        void add_node(size_t number, N *begin, size_t sz) {
+            derived().do_add_node(number, begin, sz);
+        };
+
+        void remove_edge(size_t first, const N &last) {
+            derived().do_remove_edge(first, last);
+        };
+
+        void remove_edge(size_t first) {
+            derived().do_remove_edge(first);
+        };
+
+    protected:
+        ~Graph_base() noexcept = default;
+
+    private:
+        Derived &derived() {
+            return static_cast<Derived &>(*this);
+        };
+
+        const Derived &derived() const {
+            return static_cast<const Derived &>(*this);
+        };
+    };
+
+    template<typename G, typename = void>
+    struct is_graph : std::false_type {
+    };
+
+    template<typename G>
+    struct is_graph<G, std::void_t<decltype(std::declval<const G &>().number_of_verteces()),
+            decltype(std::declval<const G &>().adjacent(size_t()))>> : std::true_type {
+    };
+
+    // type-erased interface, wrap a concrete graph into Graph_adapter to use it
     template<typename N>
     class Graph {
     public:
@@ -115,44 +267,100 @@ namespace graph {
         virtual void do_remove_edge(size_t first) = 0;
     };
 
+    template<typename G>
+    class Graph_adapter final : public Graph<typename G::node_type> {
+        using N = typename G::node_type;
+
+        G &graph;
+
+        void do_reserve(size_t cap) override {
+            graph.reserve(cap);
+        };
+
+        size_t get_number_of_verteces() const override {
+            return graph.number_of_verteces();
+        };
+
+        size_t get_number_of_edges() const override {
+            return graph.number_of_edges();
+        };
+
+        bool is_empty() const override {
+            return graph.empty();
+        };
+
+        bool check_if_weighted() const override {
+            return graph.is_weighted();
+        };
+
+        void do_add_node(size_t number, N *begin, size_t sz) override {
+            graph.add_node(number, begin, sz);
+        };
+
+        void do_remove_edge(size_t first, const N &last) override {
+            graph.remove_edge(first, last);
+        };
+
+        void do_remove_edge(size_t first) override {
+            graph.remove_edge(first);
+        };
+
+    public:
+        explicit Graph_adapter(G &new_graph_) : graph(new_graph_) {};
+
+        G &get() {
+            return graph;
+        };
+
+        const G &get() const {
+            return graph;
+        };
+
+        ~Graph_adapter() override = default;
+    };
+
     template<typename N>
-    class DirectedGraph final : public Graph<N> {
+    class DirectedGraph final : public Graph_base<DirectedGraph<N>, N> {
+        friend class Graph_base<DirectedGraph<N>, N>;
+
         size_t edges;
         bool weighted;
         std::vector<std::vector<N>> adj_list;
         std::vector<size_t> in_degrees;
 
-        void do_reserve(size_t cap) override {
+        void do_reserve(size_t cap) {
             adj_list.reserve(cap);
             in_degrees.reserve(cap);
         };
 
-        size_t get_number_of_verteces() const override {
+        size_t get_number_of_verteces() const {
             return adj_list.size();
         };
 
-        size_t get_number_of_edges() const override {
+        size_t get_number_of_edges() const {
             return edges;
         };
 
-        bool is_empty() const override {
+        bool is_empty() const {
             return adj_list.empty();
         };
 
-        bool check_if_weighted() const override {
+        bool check_if_weighted() const {
             return weighted;
         }
 
-        void do_add_node(size_t number, N *begin, size_t sz) override;
+        void do_add_node(size_t number, N *begin, size_t sz);
 
-        void do_remove_edge(size_t first, const N &last) override;
+        void do_remove_edge(size_t first, const N &last);
 
-        void do_remove_edge(size_t first) override;
+        void do_remove_edge(size_t first);
 
     public:
-        DirectedGraph() : Graph<N>(), edges(0), weighted(false) {};
+        using Graph_base<DirectedGraph<N>, N>::add_node;
+
+        DirectedGraph() : Graph_base<DirectedGraph<N>, N>(), edges(0), weighted(false) {};
 
-        DirectedGraph(size_t sz, bool w) : Graph<N>(), edges(0), weighted(w), adj_list(sz), in_degrees(sz, 0) {};
+        DirectedGraph(size_t sz, bool w) : Graph_base<DirectedGraph<N>, N>(), edges(0), weighted(w), adj_list(sz), in_degrees(sz, 0) {};
 
         DirectedGraph(const DirectedGraph &other) = default;
 
@@ -181,12 +389,21 @@ namespace graph {
         template<typename INIt>
         void add_node(size_t number, INIt begin, INIt end);
 
+        const std::vector<N> &adjacent(size_t vertex) const {
+            if (vertex >= adj_list.size())
+                throw std::invalid_argument("invalid vertex");
+
+            return adj_list[vertex];
+        };
+
         template<typename T>
         friend std::ostream &operator<<(std::ostream &os, const DirectedGraph<T> &g);
 
-        void generate_random_graph(size_t number_of_vertices, size_t number_of_edges, size_t max_weight = 0);
+        // G(n, m) from gnm_edges, the same seed gives the same graph at any thread count
+        void generate_random_graph(size_t number_of_vertices, size_t number_of_edges, size_t max_weight = 0,
+                                   uint64_t seed = std::random_device()(), size_t threads = default_threads());
 
-        ~DirectedGraph() override = default;
+        ~DirectedGraph() = default;
     };
 
     template<typename N>
@@ -214,7 +431,7 @@ namespace graph {
         if (sz == 1)
             return;
 
-        if (number < Graph<N>::number_of_verteces()) {
+        if (number < this->number_of_verteces()) {
             in_degrees[number] += sz;
 
             auto &iter = adj_list[number];
@@ -224,7 +441,7 @@ namespace graph {
             }
 
             edges += sz;
-        } else if (number == Graph<N>::number_of_verteces()) {
+        } else if (number == this->number_of_verteces()) {
             std::vector<N> tmp;
             tmp.reserve(sz);
 
@@ -245,7 +462,7 @@ namespace graph {
         if (!begin)
             throw std::invalid_argument("list of nodes");
 
-        if (number < Graph<N>::number_of_verteces()) {
+        if (number < this->number_of_verteces()) {
             in_degrees[number] += sz;
 
             auto &iter = adj_list[number];
@@ -255,7 +472,7 @@ namespace graph {
             }
 
             edges += sz;
-        } else if (number == Graph<N>::number_of_verteces()) {
+        } else if (number == this->number_of_verteces()) {
             std::vector<N> tmp;
             tmp.reserve(sz);
 
@@ -273,8 +490,8 @@ namespace graph {
 
     template<typename N>
     void DirectedGraph<N>::do_remove_edge(size_t first, const N &last) {
-        if (first >= Graph<N>::number_of_verteces() ||
-            last >= Graph<N>::number_of_verteces())      // N type must implement comparison with size_t type
+        if (first >= this->number_of_verteces() ||
+            last >= this->number_of_verteces())      // N type must implement comparison with size_t type
             throw std::invalid_argument("invalid vertices");
 
         auto &list = adj_list[first];
@@ -288,7 +505,7 @@ namespace graph {
 
     template<typename N>
     void DirectedGraph<N>::do_remove_edge(size_t first) {
-        if (first >= Graph<N>::number_of_verteces())
+        if (first >= this->number_of_verteces())
             throw std::invalid_argument("invalid vertex");
 
         for (const auto &it : adj_list[first]) {
@@ -301,177 +518,70 @@ namespace graph {
     }
 
     template<typename N>
-    void DirectedGraph<N>::generate_random_graph(size_t number_of_vertices, size_t number_of_edges, size_t max_weight) {    // wasn't tested
-        if (static_cast<uint64_t>(number_of_edges) >
-            static_cast<uint64_t>(number_of_vertices) * (number_of_vertices - 1))
-            throw std::invalid_argument("cannot create graph with such number of edges");
-
-        if (max_weight) {
-            DirectedGraph<N> result(number_of_vertices, true);
-
-            size_t already_generated = 0;
-            size_t opt_number = generate_optimal_number(number_of_vertices, number_of_edges);
-
-            std::random_device rd0;
-            std::mt19937 gen0(rd0());
-            std::uniform_int_distribution<> weight_dis(1, max_weight);
-
-            std::random_device rd1;
-            std::mt19937 gen1(rd1());
-            std::uniform_int_distribution<> vert_dis(0, number_of_vertices - 1);
-
-            std::random_device rd2;
-            std::mt19937 gen2(rd2());
-            std::uniform_int_distribution<> edge_dis(1, std::min(opt_number, number_of_vertices - 1));
-
-            std::vector<bool> vertices(number_of_vertices, false);
-
-            std::vector<bool> tmp(number_of_vertices, false);
-            while (already_generated != number_of_edges) {
-                size_t current_index = vert_dis(gen1);
-                while (vertices[current_index]) {
-                    current_index = vert_dis(gen1);
-                }
-                vertices[current_index] = true;
-
-                size_t current_edges = edge_dis(gen2);
-                while (already_generated > number_of_edges - current_edges) {
-                    current_edges = edge_dis(gen2);
-                }
-                already_generated += current_edges;
-
-                size_t tmp_counter = 0;
-                std::fill(tmp.begin(), tmp.end(), false);
-                tmp[current_index] = true;
-
-                std::vector<Node> tmp_res;
-                tmp_res.reserve(current_edges);
-                while (tmp_counter != current_edges) {
-                    size_t tmp_index = current_index;
-                    while (tmp[tmp_index]) {
-                        tmp_index = vert_dis(gen1);
-                    }
-
-                    ++tmp_counter;
-                    tmp[tmp_index] = true;
-
-                    ++result.in_degrees[tmp_index];
-                    tmp_res.emplace_back(tmp_index, weight_dis(gen0));
-                }
-
-                result.adj_list[current_edges] = std::move(tmp_res);
-            }
-
-            *this = std::move(result);
-        } else {
-            DirectedGraph<N> result(number_of_vertices, false);
-
-            size_t already_generated = 0;
-            size_t opt_number = generate_optimal_number(number_of_vertices, number_of_edges);
-
-            std::random_device rd1;
-            std::mt19937 gen1(rd1());
-            std::uniform_int_distribution<> vert_dis(0, number_of_vertices - 1);
-
-            std::random_device rd2;
-            std::mt19937 gen2(rd2());
-            std::uniform_int_distribution<> edge_dis(1, std::min(opt_number, number_of_vertices - 1));
+    void DirectedGraph<N>::generate_random_graph(size_t number_of_vertices, size_t number_of_edges, size_t max_weight,
+                                                 uint64_t seed, size_t threads) {
+        if (!fits_vertices<N>(number_of_vertices))
+            throw std::length_error("vertex type");
+
+        DirectedGraph<N> result(number_of_vertices, max_weight != 0);
+        gnm_edges(number_of_vertices, number_of_edges, true, seed, [&result](size_t first, size_t last, size_t weight) {
+            ++result.in_degrees[last];
+            result.adj_list[first].push_back(make_node<N>(last, weight));
+        }, max_weight, threads);
+        result.edges = number_of_edges;
 
-            std::vector<bool> vertices(number_of_vertices, false);
-
-            std::vector<bool> tmp(number_of_vertices, false);
-            while (already_generated != number_of_edges) {
-                size_t current_index = vert_dis(gen1);
-                size_t current_edges = edge_dis(gen2);
-
-                if (std::count(vertices.begin(), vertices.end(), false) > 1) {
-                    while (vertices[current_index]) {
-                        current_index = vert_dis(gen1);
-                    }
-
-                    while (already_generated + current_edges > number_of_edges) {
-                        current_edges = edge_dis(gen2);
-                    }
-                    already_generated += current_edges;
-                } else {
-                    current_index = std::find(vertices.begin(), vertices.end(), false) - vertices.begin();
-
-                    current_edges = number_of_edges - already_generated;
-                    already_generated = number_of_edges;
-                }
-
-                vertices[current_index] = true;
-
-                size_t tmp_counter = 0;
-                std::fill(tmp.begin(), tmp.end(), false);
-                tmp[current_index] = true;
-
-                std::vector<size_t> tmp_res;
-                tmp_res.reserve(current_edges);
-                while (tmp_counter != current_edges) {
-                    size_t tmp_index = current_index;
-                    while (tmp[tmp_index]) {
-                        tmp_index = vert_dis(gen1);
-                    }
-
-                    ++tmp_counter;
-                    tmp[tmp_index] = true;
-
-                    ++result.in_degrees[tmp_index];
-                    tmp_res.emplace_back(tmp_index);
-                }
-
-                result.adj_list[current_index] = std::move(tmp_res);
-            }
-
-            *this = std::move(result);
-        }
+        *this = std::move(result);
     }
 
     template<typename N>
     decltype(auto)
-    generate_random_directed_graph(size_t number_of_vertices, size_t number_of_edges, size_t max_weight = 0) {  // respectively wasn't tested
+    generate_random_directed_graph(size_t number_of_vertices, size_t number_of_edges, size_t max_weight = 0,
+                                   uint64_t seed = std::random_device()()) {
         DirectedGraph<N> result;
-        result.generate_random_graph(number_of_vertices, number_of_edges, max_weight);
+        result.generate_random_graph(number_of_vertices, number_of_edges, max_weight, seed);
         return result;
     }
 
     template<typename N>
-    class UndirectedGraph final : public Graph<N> {
+    class UndirectedGraph final : public Graph_base<UndirectedGraph<N>, N> {
+        friend class Graph_base<UndirectedGraph<N>, N>;
+
         size_t edges;
         bool weighted;
         std::vector<std::vector<N>> adj_list;
 
-        void do_reserve(size_t cap) override {
+        void do_reserve(size_t cap) {
             adj_list.reserve(cap);
         };
 
-        size_t get_number_of_verteces() const override {
+        size_t get_number_of_verteces() const {
             return adj_list.size();
         };
 
-        size_t get_number_of_edges() const override {
+        size_t get_number_of_edges() const {
             return edges;
         };
 
-        bool is_empty() const override {
+        bool is_empty() const {
             return adj_list.empty();
         };
 
-        bool check_if_weighted() const override {
+        bool check_if_weighted() const {
             return weighted;
         };
 
-        void do_add_node(size_t number, N *begin, size_t sz) override;
+        void do_add_node(size_t number, N *begin, size_t sz);
 
-        void do_remove_edge(size_t first, const N &last) override;
+        void do_remove_edge(size_t first, const N &last);
 
-        void do_remove_edge(size_t first) override;
+        void do_remove_edge(size_t first);
 
     public:
-        UndirectedGraph() : Graph<N>(), edges(0), weighted(false) {};
+        using Graph_base<UndirectedGraph<N>, N>::add_node;
 
-        UndirectedGraph(size_t sz, bool w) : Graph<N>(), edges(0), weighted(w), adj_list(sz) {};
+        UndirectedGraph() : Graph_base<UndirectedGraph<N>, N>(), edges(0), weighted(false) {};
+
+        UndirectedGraph(size_t sz, bool w) : Graph_base<UndirectedGraph<N>, N>(), edges(0), weighted(w), adj_list(sz) {};
 
         UndirectedGraph(const UndirectedGraph &other) = default;
 
@@ -499,12 +609,20 @@ namespace graph {
         template<typename INIt>
         void add_node(size_t number, INIt begin, INIt end);
 
+        const std::vector<N> &adjacent(size_t vertex) const {
+            if (vertex >= adj_list.size())
+                throw std::invalid_argument("invalid vertex");
+
+            return adj_list[vertex];
+        };
+
         template<typename T>
         friend std::ostream &operator<<(std::ostream &os, const UndirectedGraph<T> &g);
 
-        void generate_random_graph(size_t number_of_vertices, size_t number_of_edges);
+        void generate_random_graph(size_t number_of_vertices, size_t number_of_edges,
+                                   uint64_t seed = std::random_device()(), size_t threads = default_threads());
 
-        ~UndirectedGraph() override = default;
+        ~UndirectedGraph() = default;
     };
 
     template<typename N>
@@ -532,21 +650,21 @@ namespace graph {
         if (sz == 1)
             return;
 
-        if (number < Graph<N>::number_of_verteces()) {
+        if (number < this->number_of_verteces()) {
             auto &iter = adj_list[number];
             for (auto &it = begin; it != end; it = std::next(it)) {
                 iter.push_back(*it);
-                adj_list[static_cast<size_t>(*it)].push_back(static_cast<N>(number));
+                adj_list[static_cast<size_t>(*it)].push_back(make_node<N>(number, edge_weight(*it)));     // the mirror keeps the weight
             }
 
             edges += sz;
-        } else if (number == Graph<N>::number_of_verteces()) {
+        } else if (number == this->number_of_verteces()) {
             std::vector<N> tmp;
             tmp.reserve(sz);
 
             for (auto &it = begin; it != end; it = std::next(it)) {
                 tmp.push_back(*it);
-                adj_list[static_cast<size_t>(*it)].push_back(static_cast<N>(number));
+                adj_list[static_cast<size_t>(*it)].push_back(make_node<N>(number, edge_weight(*it)));
             }
 
             adj_list.emplace_back(std::move(tmp));
@@ -560,21 +678,21 @@ namespace graph {
         if (!begin)
             throw std::invalid_argument("list of nodes");
 
-        if (number < Graph<N>::number_of_verteces()) {
+        if (number < this->number_of_verteces()) {
             auto &iter = adj_list[number];
             for (size_t i = 0; i < sz; ++i) {
                 iter.push_back(*(begin + i));
-                adj_list[static_cast<size_t>(*(begin + i))].push_back(static_cast<N>(number));
+                adj_list[static_cast<size_t>(*(begin + i))].push_back(make_node<N>(number, edge_weight(*(begin + i))));
             }
 
             edges += sz;
-        } else if (number == Graph<N>::number_of_verteces()) {
+        } else if (number == this->number_of_verteces()) {
             std::vector<N> tmp;
             tmp.reserve(sz);
 
             for (size_t i = 0; i < sz; ++i) {
                 tmp.push_back(*(begin + i));
-                adj_list[static_cast<size_t>(*(begin + i))].push_back(static_cast<N>(number));
+                adj_list[static_cast<size_t>(*(begin + i))].push_back(make_node<N>(number, edge_weight(*(begin + i))));
             }
 
             adj_list.emplace_back(std::move(tmp));
@@ -585,8 +703,8 @@ namespace graph {
 
     template<typename N>
     void UndirectedGraph<N>::do_remove_edge(size_t first, const N &last) {
-        if (first >= Graph<N>::number_of_verteces() ||
-            last >= Graph<N>::number_of_verteces())      // N type must implement comparison with size_t type
+        if (first >= this->number_of_verteces() ||
+            last >= this->number_of_verteces())      // N type must implement comparison with size_t type
             throw std::invalid_argument("invalid vertices");
 
         auto &list = adj_list[first];
@@ -607,11 +725,17 @@ namespace graph {
 
     template<typename N>
     void UndirectedGraph<N>::do_remove_edge(size_t first) {
-        if (first >= Graph<N>::number_of_verteces())
+        if (first >= this->number_of_verteces())
             throw std::invalid_argument("invalid vertex");
 
         auto &list = adj_list[first];
+        size_t loops = 0;       // a loop is stored twice in this very list and counts as one edge
         for (size_t i = 0, end_ = list.size(); i < end_; ++i) {
+            if (first == list[i]) {
+                ++loops;
+                continue;
+            }
+
             auto &tmp = adj_list[static_cast<size_t>(list[i])];
             auto iter = std::find_if(tmp.begin(), tmp.end(), [first](const N &other) {
                 return first == other;
@@ -619,123 +743,31 @@ namespace graph {
             tmp.erase(iter);
         }
 
-        edges -= list.size();
+        edges -= list.size() - loops / 2;
         list.clear();
     }
 
     template<typename N>
-    void UndirectedGraph<N>::generate_random_graph(size_t number_of_vertices,
-                                                   size_t number_of_edges) {    // was tested, must work
-        if (static_cast<uint64_t>(number_of_edges) >
-            static_cast<uint64_t>(number_of_vertices) * (number_of_vertices - 1) / 2)
-            throw std::invalid_argument("cannot create graph with such number of edges");
+    void UndirectedGraph<N>::generate_random_graph(size_t number_of_vertices, size_t number_of_edges, uint64_t seed,
+                                                   size_t threads) {
+        if (!fits_vertices<N>(number_of_vertices))
+            throw std::length_error("vertex type");
 
         UndirectedGraph<N> result(number_of_vertices, false);
-
-        size_t already_generated = 0;
-        size_t opt_number = generate_optimal_number(number_of_vertices, number_of_edges);
-
-        std::random_device rd1;
-        std::mt19937 gen1(rd1());
-        std::uniform_int_distribution<> vert_dis(0, number_of_vertices - 1);
-
-        std::random_device rd2;
-        std::mt19937 gen2(rd2());
-        std::uniform_int_distribution<> edge_dis(1, std::min(opt_number, number_of_vertices - 1));
-
-        std::vector<bool> vertices(number_of_vertices, false);
-
-        std::vector<bool> tmp(number_of_vertices, false);
-        while (already_generated != number_of_edges) {
-            size_t current_index = vert_dis(gen1);
-            size_t current_edges = edge_dis(gen2);
-
-            if (std::count(vertices.begin(), vertices.end(), false) > 1) {
-                while (vertices[current_index]) {
-                    current_index = vert_dis(gen1);
-                }
-
-                while (already_generated + current_edges > number_of_edges) {
-                    current_edges = edge_dis(gen2);
-                }
-                already_generated += current_edges;
-            } else {
-                current_index = std::find(vertices.begin(), vertices.end(), false) - vertices.begin();
-
-                current_edges = number_of_edges - already_generated;
-                already_generated = number_of_edges;
-
-                while (current_edges >= number_of_vertices) {
-                    std::vector<bool> tmp_mask(number_of_vertices, false);
-
-                    for (size_t i = 0; i < number_of_vertices; ++i) {
-                        if (result.adj_list[i].size() < number_of_vertices) {
-                            size_t decrement = number_of_vertices - result.adj_list[i].size();
-
-                            std::fill(tmp_mask.begin(), tmp_mask.end(), false);
-                            tmp_mask[i] = true;
-                            for (auto &it : result.adj_list[i])
-                                tmp_mask[it] = true;
-
-                            size_t tmp_counter = 0;
-                            while (tmp_counter != decrement) {
-                                size_t tmp_index = i;
-                                while (tmp_mask[i])
-                                    tmp_index = vert_dis(gen1);
-
-                                ++tmp_counter;
-                                tmp_mask[tmp_index] = true;
-
-                                result.adj_list[tmp_index].emplace_back(i);
-                                result.adj_list[i].emplace_back(tmp_index);
-                            }
-
-                            current_edges -= decrement;
-                        }
-                    }
-                }
-            }
-
-            vertices[current_index] = true;
-
-            size_t initial_size = result.adj_list[current_index].size();
-
-            size_t tmp_counter = 0;
-            std::fill(tmp.begin(), tmp.end(), false);
-            tmp[current_index] = true;
-
-            if (initial_size) {
-                for (const auto &it : result.adj_list[current_index])
-                    tmp[it] = true;
-            }
-
-            std::vector<size_t> tmp_res;
-            tmp_res.reserve(current_edges);
-            while (tmp_counter != current_edges) {
-                size_t tmp_index = current_index;
-                while (tmp[tmp_index]) {
-                    tmp_index = vert_dis(gen1);
-                }
-
-                ++tmp_counter;
-                tmp[tmp_index] = true;
-
-                tmp_res.emplace_back(tmp_index);
-                result.adj_list[tmp_index].emplace_back(current_index);
-            }
-
-            result.adj_list[current_index].insert(result.adj_list[current_index].end(),
-                                                  std::make_move_iterator(tmp_res.begin()),
-                                                  std::make_move_iterator(tmp_res.end()));
-        }
+        gnm_edges(number_of_vertices, number_of_edges, false, seed, [&result](size_t first, size_t last, size_t) {
+            result.adj_list[first].push_back(make_node<N>(last, 1));
+            result.adj_list[last].push_back(make_node<N>(first, 1));
+        }, 0, threads);
+        result.edges = number_of_edges;
 
         *this = std::move(result);
     }
 
     template<typename N>
-    decltype(auto) generate_random_undirected_unweighted_graph(size_t number_of_vertices, size_t number_of_edges) {
+    decltype(auto) generate_random_undirected_unweighted_graph(size_t number_of_vertices, size_t number_of_edges,
+                                                               uint64_t seed = std::random_device()()) {
         UndirectedGraph<N> result;
-        result.generate_random_graph(number_of_vertices, number_of_edges);
+        result.generate_random_graph(number_of_vertices, number_of_edges, seed);
         return result;
     }
 }
@@ -0,0 +1,369 @@
+#pragma once
+
+#ifndef GRAPH_GRAPH_FILE_H
+#define GRAPH_GRAPH_FILE_H
+
+#endif //GRAPH_GRAPH_FILE_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CSR_graph.h"
+
+namespace graph {
+    // layout: header, then offsets (uint64), targets (V) and weights (W) each starting at a 64-byte boundary,
+    // all in native byte order
+    struct Graph_file_header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;        // 0x01020304 as written by the producing machine
+        uint32_t flags;
+        uint32_t vertex_type;
+        uint32_t weight_type;       // 0 for unweighted graphs
+        uint32_t reserved;
+        uint64_t vertices;
+        uint64_t entries;           // length of the targets section, undirected edges are stored twice
+        uint64_t edges;
+        uint64_t offsets_position;
+        uint64_t targets_position;
+        uint64_t weights_position;
+        uint64_t file_size;
+        uint64_t offsets_checksum;
+        uint64_t targets_checksum;
+        uint64_t weights_checksum;
+        uint64_t header_checksum;   // over the header with this field zeroed
+    };
+
+    static constexpr char graph_file_magic[8] = {'G', 'R', 'A', 'P', 'H', 'B', 'I', 'N'};
+    static constexpr uint32_t graph_file_version = 1;
+    static constexpr uint32_t graph_file_byte_order = 0x01020304;
+    static constexpr uint32_t graph_file_directed = 1;
+    static constexpr uint64_t graph_file_alignment = 64;
+
+    template<typename T>
+    constexpr uint32_t graph_file_type() {     // size in the low byte, kind in the next one
+        return static_cast<uint32_t>(sizeof(T)) |
+               (std::is_floating_point<T>::value ? 2u : std::is_signed<T>::value ? 1u : 0u) << 8;
+    }
+
+    inline uint64_t graph_file_align(uint64_t position) {
+        return (position + graph_file_alignment - 1) / graph_file_alignment * graph_file_alignment;
+    }
+
+    // four independent multiply-rotate lanes over 8-byte words, fast enough to run at memory speed
+    inline uint64_t checksum64(const void *data, size_t bytes) {
+        constexpr uint64_t prime = 0x9E3779B97F4A7C15ull;
+
+        const auto *bytes_ptr = static_cast<const unsigned char *>(data);
+        uint64_t lanes[4] = {prime, prime * 3, prime * 5, prime * 7};
+        auto step = [prime](uint64_t lane, uint64_t word) {
+            lane = (lane ^ word) * prime;
+            return (lane << 29) | (lane >> 35);
+        };
+
+        size_t i = 0;
+        for (; i + 32 <= bytes; i += 32) {
+            for (size_t j = 0; j < 4; ++j) {
+                uint64_t word;
+                std::memcpy(&word, bytes_ptr + i + 8 * j, 8);
+                lanes[j] = step(lanes[j], word);
+            }
+        }
+        for (size_t j = 0; i < bytes; i += 8, ++j) {
+            uint64_t word = 0;
+            std::memcpy(&word, bytes_ptr + i, std::min<size_t>(8, bytes - i));
+            lanes[j] = step(lanes[j], word);
+        }
+
+        uint64_t result = bytes;
+        for (auto it : lanes)
+            result = step(result, it);
+        result = (result ^ (result >> 31)) * 0xBF58476D1CE4E5B9ull;
+
+        return result ^ (result >> 29);
+    }
+
+    inline void write_all(int fd, const void *data, size_t bytes) {
+        const auto *position = static_cast<const char *>(data);
+        while (bytes) {
+            auto written = ::write(fd, position, bytes);
+            if (written < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category(), "write");
+            }
+
+            position += written;
+            bytes -= static_cast<size_t>(written);
+        }
+    }
+
+    template<typename V, typename W>
+    void write_graph(const CSR_graph<V, W> &g, const std::string &path) {
+        const auto &offsets = g.get_offsets();
+        const auto &targets = g.get_targets();
+        const auto &weights = g.get_weights();
+        std::vector<uint64_t> file_offsets(offsets.begin(), offsets.end());
+
+        Graph_file_header header{};
+        std::memcpy(header.magic, graph_file_magic, sizeof(graph_file_magic));
+        header.version = graph_file_version;
+        header.byte_order = graph_file_byte_order;
+        header.flags = g.is_directed() ? graph_file_directed : 0;
+        header.vertex_type = graph_file_type<V>();
+        header.weight_type = g.is_weighted() ? graph_file_type<W>() : 0;
+        header.vertices = g.number_of_verteces();
+        header.entries = targets.size();
+        header.edges = g.number_of_edges();
+        header.offsets_position = graph_file_align(sizeof(Graph_file_header));
+        header.targets_position = graph_file_align(header.offsets_position + file_offsets.size() * sizeof(uint64_t));
+        header.weights_position = graph_file_align(header.targets_position + targets.size() * sizeof(V));
+        header.file_size = header.weights_position + weights.size() * sizeof(W);
+        header.offsets_checksum = checksum64(file_offsets.data(), file_offsets.size() * sizeof(uint64_t));
+        header.targets_checksum = checksum64(targets.data(), targets.size() * sizeof(V));
+        header.weights_checksum = checksum64(weights.data(), weights.size() * sizeof(W));
+        header.header_checksum = checksum64(&header, sizeof(header));
+
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "open");
+
+        try {
+            const char padding[graph_file_alignment] = {};
+            uint64_t position = 0;
+            auto section = [&](uint64_t start, const void *data, size_t bytes) {
+                write_all(fd, padding, start - position);
+                write_all(fd, data, bytes);
+                position = start + bytes;
+            };
+
+            section(0, &header, sizeof(header));
+            section(header.offsets_position, file_offsets.data(), file_offsets.size() * sizeof(uint64_t));
+            section(header.targets_position, targets.data(), targets.size() * sizeof(V));
+            section(header.weights_position, weights.data(), weights.size() * sizeof(W));
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+
+        if (::close(fd) != 0)
+            throw std::system_error(errno, std::generic_category(), "close");
+    }
+
+    template<typename V = void, typename W = void, typename N>
+    void write_graph(const DirectedGraph<N> &g, const std::string &path) {
+        write_graph(freeze<V, W>(g), path);
+    }
+
+    template<typename V = void, typename W = void, typename N>
+    void write_graph(const UndirectedGraph<N> &g, const std::string &path) {
+        write_graph(freeze<V, W>(g), path);
+    }
+
+    // read-only CSR view straight over a mapped graph file, nothing is copied or parsed;
+    // checksums are only compared on request since that reads the whole file
+    template<typename V = size_t, typename W = size_t>
+    class Mapped_graph final {
+        void *mapping;
+        size_t mapped_bytes;
+        const Graph_file_header *header;
+        const uint64_t *offsets;
+        const V *targets;
+        const W *weights;
+
+        void unmap() noexcept {
+            if (mapping)
+                ::munmap(mapping, mapped_bytes);
+
+            mapping = nullptr;
+            mapped_bytes = 0;
+        };
+
+        const char *section(uint64_t position) const {
+            return static_cast<const char *>(mapping) + position;
+        };
+
+    public:
+        using vertex_type = V;
+        using weight_type = W;
+
+        explicit Mapped_graph(const std::string &path, bool verify_checksums = false);
+
+        Mapped_graph(const Mapped_graph &other) = delete;
+
+        Mapped_graph &operator=(const Mapped_graph &other) = delete;
+
+        Mapped_graph(Mapped_graph &&other) noexcept: mapping(other.mapping), mapped_bytes(other.mapped_bytes),
+                                                     header(other.header), offsets(other.offsets),
+                                                     targets(other.targets), weights(other.weights) {
+            other.mapping = nullptr;
+            other.mapped_bytes = 0;
+        };
+
+        Mapped_graph &operator=(Mapped_graph &&other) noexcept {
+            if (this == &other)
+                return *this;
+
+            unmap();
+            mapping = other.mapping;
+            mapped_bytes = other.mapped_bytes;
+            header = other.header;
+            offsets = other.offsets;
+            targets = other.targets;
+            weights = other.weights;
+
+            other.mapping = nullptr;
+            other.mapped_bytes = 0;
+
+            return *this;
+        };
+
+        ~Mapped_graph() noexcept {
+            unmap();
+        };
+
+        size_t number_of_verteces() const {
+            return header->vertices;
+        };
+
+        size_t number_of_edges() const {
+            return header->edges;
+        };
+
+        bool empty() const {
+            return !header->vertices;
+        };
+
+        bool is_weighted() const {
+            return header->weight_type != 0;
+        };
+
+        bool is_directed() const {
+            return header->flags & graph_file_directed;
+        };
+
+        size_t degree(size_t vertex) const {
+            return offsets[vertex + 1] - offsets[vertex];
+        };
+
+        Adjacency_range<V> adjacent(size_t vertex) const {
+            return Adjacency_range<V>(targets + offsets[vertex], targets + offsets[vertex + 1]);
+        };
+
+        Adjacency_range<W> adjacent_weights(size_t vertex) const {     // empty range for unweighted graphs
+            if (!weights)
+                return Adjacency_range<W>(nullptr, nullptr);
+
+            return Adjacency_range<W>(weights + offsets[vertex], weights + offsets[vertex + 1]);
+        };
+
+        bool verify() const;
+    };
+
+    template<typename V, typename W>
+    Mapped_graph<V, W>::Mapped_graph(const std::string &path, bool verify_checksums) : mapping(nullptr), mapped_bytes(0),
+                                                                                     header(nullptr), offsets(nullptr),
+                                                                                     targets(nullptr), weights(nullptr) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "open");
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0) {
+            auto error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "fstat");
+        }
+
+        auto bytes = static_cast<size_t>(info.st_size);
+        if (bytes < sizeof(Graph_file_header)) {
+            ::close(fd);
+            throw std::runtime_error("not a graph file");
+        }
+
+        mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        auto error = errno;
+        ::close(fd);        // the mapping keeps the file alive
+        if (mapping == MAP_FAILED) {
+            mapping = nullptr;
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+        mapped_bytes = bytes;
+
+        try {
+            header = static_cast<const Graph_file_header *>(mapping);
+
+            auto copy = *header;
+            copy.header_checksum = 0;
+            if (std::memcmp(header->magic, graph_file_magic, sizeof(graph_file_magic)) != 0 ||
+                checksum64(&copy, sizeof(copy)) != header->header_checksum)
+                throw std::runtime_error("not a graph file");
+            if (header->version != graph_file_version || header->byte_order != graph_file_byte_order)
+                throw std::runtime_error("unsupported graph file");
+            if (header->vertex_type != graph_file_type<V>() ||
+                (header->weight_type && header->weight_type != graph_file_type<W>()))
+                throw std::invalid_argument("graph file types");
+
+            // count elements of size bytes from position stay below limit; written as a quotient so that a
+            // crafted header cannot overflow the products or the sums
+            auto fits = [](uint64_t position, uint64_t count, uint64_t size, uint64_t limit) {
+                return position <= limit && count <= (limit - position) / size;
+            };
+
+            uint64_t weight_entries = header->weight_type ? header->entries : 0;
+            if (header->file_size != bytes ||
+                header->offsets_position % graph_file_alignment || header->targets_position % graph_file_alignment ||
+                header->weights_position % graph_file_alignment ||
+                header->offsets_position < sizeof(Graph_file_header) ||
+                header->vertices == std::numeric_limits<uint64_t>::max() ||
+                !fits(header->offsets_position, header->vertices + 1, sizeof(uint64_t), header->targets_position) ||
+                !fits(header->targets_position, header->entries, sizeof(V), header->weights_position) ||
+                !fits(header->weights_position, weight_entries, sizeof(W), bytes) ||
+                header->weights_position + weight_entries * sizeof(W) != bytes)
+                throw std::runtime_error("corrupted graph file");
+
+            offsets = reinterpret_cast<const uint64_t *>(section(header->offsets_position));
+            targets = reinterpret_cast<const V *>(section(header->targets_position));
+            weights = weight_entries ? reinterpret_cast<const W *>(section(header->weights_position)) : nullptr;
+            if (offsets[0] != 0 || offsets[header->vertices] != header->entries)
+                throw std::runtime_error("corrupted graph file");
+
+            if (verify_checksums && !verify())
+                throw std::runtime_error("corrupted graph file");
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    template<typename V, typename W>
+    bool Mapped_graph<V, W>::verify() const {      // checksums plus monotone offsets and targets in range
+        uint64_t weight_entries = weights ? header->entries : 0;
+        if (checksum64(offsets, (header->vertices + 1) * sizeof(uint64_t)) != header->offsets_checksum ||
+            checksum64(targets, header->entries * sizeof(V)) != header->targets_checksum ||
+            checksum64(weights, weight_entries * sizeof(W)) != header->weights_checksum)
+            return false;
+
+        for (uint64_t i = 0; i < header->vertices; ++i)
+            if (offsets[i] > offsets[i + 1])
+                return false;
+        for (uint64_t i = 0; i < header->entries; ++i)
+            if (static_cast<uint64_t>(targets[i]) >= header->vertices)
+                return false;
+
+        return true;
+    }
+}
@@ -0,0 +1,324 @@
+#pragma once
+
+#ifndef GRAPH_GRAPH_PARSER_H
+#define GRAPH_GRAPH_PARSER_H
+
+#endif //GRAPH_GRAPH_PARSER_H
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CSR_graph.h"
+#include "parallel.h"
+
+namespace graph {
+    enum class Text_format {
+        edge_list,          // "first last [weight]" per line
+        adjacency_list,     // operator<< output: "vertex: next next ..." or "vertex: (next, weight) ..."
+        matrix_market       // coordinate Matrix Market, directedness and weights come from its header
+    };
+
+    // cursor over one line; whitespace is spaces and tabs, lines end with '\n' (a trailing '\r' is skipped)
+    class Line_scanner final {
+        const char *position;
+        const char *last;
+
+    public:
+        Line_scanner(const char *new_position_, const char *new_last_) : position(new_position_), last(new_last_) {};
+
+        void skip_blanks() {
+            while (position != last && (*position == ' ' || *position == '\t' || *position == '\r'))
+                ++position;
+        };
+
+        bool at_end() {
+            skip_blanks();
+            return position == last;
+        };
+
+        bool accept(char symbol) {
+            skip_blanks();
+            if (position == last || *position != symbol)
+                return false;
+
+            ++position;
+            return true;
+        };
+
+        template<typename T>
+        bool number(T &value) {
+            skip_blanks();
+            if (position != last && *position == '+')
+                ++position;
+
+            auto result = std::from_chars(position, last, value);
+            if (result.ec != std::errc())
+                return false;
+
+            position = result.ptr;
+            return true;
+        };
+    };
+
+    struct Parsed_edge {
+        uint64_t first;
+        uint64_t last;
+        double weight;
+    };
+
+    struct Matrix_market_header {
+        bool directed;
+        bool weighted;
+        uint64_t vertices;
+        const char *body;       // first line after the size line
+    };
+
+    inline Matrix_market_header parse_matrix_market_header(const char *first, const char *last) {
+        auto line_end = [last](const char *position) {
+            auto result = static_cast<const char *>(std::memchr(position, '\n', last - position));
+            return result ? result : last;
+        };
+
+        auto end_ = line_end(first);
+        std::string banner(first, end_);
+        std::transform(banner.begin(), banner.end(), banner.begin(), [](unsigned char symbol) {
+            return static_cast<char>(std::tolower(symbol));
+        });
+        if (banner.compare(0, 14, "%%matrixmarket") != 0 || banner.find("coordinate") == std::string::npos)
+            throw std::runtime_error("matrix market header");
+        if (banner.find("complex") != std::string::npos)
+            throw std::runtime_error("matrix market field");
+
+        Matrix_market_header result{};
+        result.directed = banner.find("general") != std::string::npos;
+        result.weighted = banner.find("pattern") == std::string::npos;
+
+        for (auto position = end_; position != last; position = end_) {
+            ++position;
+            end_ = line_end(position);
+
+            Line_scanner scanner(position, end_);
+            if (scanner.at_end() || scanner.accept('%'))
+                continue;
+
+            uint64_t rows = 0;
+            uint64_t columns = 0;
+            uint64_t entries = 0;
+            if (!scanner.number(rows) || !scanner.number(columns) || !scanner.number(entries) || rows != columns)
+                throw std::runtime_error("matrix market size");
+
+            result.vertices = rows;
+            result.body = end_ == last ? last : end_ + 1;
+            return result;
+        }
+
+        throw std::runtime_error("matrix market size");
+    }
+
+    // parses the lines of [first, last), emit(edge) is called for every edge; returns the largest vertex seen plus one
+    template<typename F>
+    uint64_t parse_lines(const char *first, const char *last, Text_format format, bool weighted, F emit) {
+        uint64_t result = 0;
+        while (first != last) {
+            auto end_ = static_cast<const char *>(std::memchr(first, '\n', last - first));
+            if (!end_)
+                end_ = last;
+
+            Line_scanner scanner(first, end_);
+            bool skip = scanner.at_end() || scanner.accept('#') || scanner.accept('%');
+            bool valid = true;
+            if (!skip && format == Text_format::adjacency_list) {
+                uint64_t vertex = 0;
+                valid = scanner.number(vertex) && scanner.accept(':');
+                result = std::max(result, vertex + 1);
+                while (valid && !scanner.at_end()) {
+                    Parsed_edge edge{vertex, 0, 1.0};
+                    if (scanner.accept('(')) {
+                        valid = scanner.number(edge.last) && scanner.accept(',') && scanner.number(edge.weight) &&
+                                scanner.accept(')');
+                    } else {
+                        valid = scanner.number(edge.last);
+                    }
+
+                    if (!weighted)
+                        edge.weight = 1.0;
+                    result = std::max(result, edge.last + 1);
+                    emit(edge);
+                }
+            } else if (!skip) {
+                Parsed_edge edge{0, 0, 1.0};
+                valid = scanner.number(edge.first) && scanner.number(edge.last);
+                if (valid && !scanner.at_end()) {
+                    double weight = 1.0;
+                    valid = scanner.number(weight);
+                    if (weighted)
+                        edge.weight = weight;
+                }
+
+                if (format == Text_format::matrix_market) {
+                    valid = valid && edge.first && edge.last;       // one-based
+                    --edge.first;
+                    --edge.last;
+                }
+                result = std::max({result, edge.first + 1, edge.last + 1});
+                emit(edge);
+            }
+
+            if (!valid)
+                throw std::runtime_error("malformed line: " + std::string(first, end_));
+
+            first = end_ == last ? last : end_ + 1;
+        }
+
+        return result;
+    }
+
+    // lines are parsed in parallel chunks. Vertices belong to workers in blocks of owner_block ids, taken
+    // round-robin, and every chunk files its edges under the owner of the source; a mirrored half is filed
+    // separately only when its source has another owner. A worker then counts and fills only its own vertices,
+    // reading its buckets in chunk order: one degree array whatever the thread count, no atomics, and
+    // neighbours keep file order
+    template<typename V = size_t, typename W = size_t>
+    CSR_graph<V, W> parse_graph(const char *first, const char *last, Text_format format, bool directed, bool weighted,
+                                size_t threads = default_threads()) {
+        constexpr size_t chunk_bytes = size_t(1) << 20;
+        constexpr uint64_t owner_block = 4096;
+
+        uint64_t declared_vertices = 0;
+        if (format == Text_format::matrix_market) {
+            auto header = parse_matrix_market_header(first, last);
+            directed = header.directed;
+            weighted = weighted && header.weighted;
+            declared_vertices = header.vertices;
+            first = header.body;
+        }
+        if (!threads)
+            threads = 1;
+
+        std::vector<const char *> bounds(1, first);
+        while (bounds.back() != last) {
+            auto position = bounds.back() + std::min<size_t>(chunk_bytes, last - bounds.back());
+            auto line_end = static_cast<const char *>(std::memchr(position, '\n', last - position));
+            bounds.push_back(line_end ? line_end + 1 : last);
+        }
+        size_t chunks = bounds.size() - 1;
+
+        bool mirror = !directed && format != Text_format::adjacency_list;     // adjacency lists already hold both ends
+        size_t workers = std::max<size_t>(1, std::min(threads, chunks));
+        auto owner = [workers](uint64_t vertex) {
+            return static_cast<size_t>(vertex / owner_block % workers);
+        };
+
+        std::vector<std::vector<std::vector<Parsed_edge>>> parsed(chunks, std::vector<std::vector<Parsed_edge>>(workers));
+        std::vector<uint64_t> chunk_vertices(chunks, 0);
+        parallel_for(0, chunks, threads, 1, [&](size_t, size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                auto &buckets = parsed[i];
+                chunk_vertices[i] = parse_lines(bounds[i], bounds[i + 1], format, weighted, [&](const Parsed_edge &edge) {
+                    buckets[owner(edge.first)].push_back(edge);
+                    if (mirror && owner(edge.last) != owner(edge.first))
+                        buckets[owner(edge.last)].push_back(Parsed_edge{edge.last, edge.first, edge.weight});
+                });
+            }
+        });
+
+        uint64_t vertices = declared_vertices;
+        for (auto it : chunk_vertices)
+            vertices = std::max(vertices, it);
+        if (declared_vertices && vertices > declared_vertices)
+            throw std::runtime_error("matrix market entry out of range");
+        if (vertices && vertices - 1 > static_cast<uint64_t>(std::numeric_limits<V>::max()))
+            throw std::length_error("vertex type");
+
+        std::vector<size_t> offsets(vertices + 1, 0);
+        parallel_for(0, workers, workers, 1, [&](size_t, size_t lo_worker, size_t hi_worker) {
+            for (size_t worker = lo_worker; worker < hi_worker; ++worker)
+                for (size_t i = 0; i < chunks; ++i)
+                    for (const auto &it : parsed[i][worker]) {
+                        ++offsets[it.first + 1];
+                        if (mirror && owner(it.last) == worker)        // filed mirrors always have a foreign end
+                            ++offsets[it.last + 1];
+                    }
+        });
+        parallel_prefix_sum(offsets, threads);
+
+        std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+        std::vector<V> targets(offsets.back());
+        std::vector<W> weights(weighted ? offsets.back() : 0);
+        parallel_for(0, workers, workers, 1, [&](size_t, size_t lo_worker, size_t hi_worker) {
+            for (size_t worker = lo_worker; worker < hi_worker; ++worker) {
+                for (size_t i = 0; i < chunks; ++i) {
+                    for (const auto &it : parsed[i][worker]) {
+                        auto position = cursor[it.first]++;
+                        targets[position] = static_cast<V>(it.last);
+                        if (weighted)
+                            weights[position] = static_cast<W>(it.weight);
+
+                        if (mirror && owner(it.last) == worker) {
+                            position = cursor[it.last]++;
+                            targets[position] = static_cast<V>(it.first);
+                            if (weighted)
+                                weights[position] = static_cast<W>(it.weight);
+                        }
+                    }
+                    std::vector<Parsed_edge>().swap(parsed[i][worker]);
+                }
+            }
+        });
+
+        return CSR_graph<V, W>(directed, std::move(offsets), std::move(targets), std::move(weights));
+    }
+
+    template<typename V = size_t, typename W = size_t>
+    CSR_graph<V, W> read_graph(const std::string &path, Text_format format, bool directed, bool weighted,
+                               size_t threads = default_threads()) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "open");
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0) {
+            auto error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "fstat");
+        }
+
+        auto bytes = static_cast<size_t>(info.st_size);
+        if (!bytes) {
+            ::close(fd);
+            return parse_graph<V, W>(nullptr, nullptr, format, directed, weighted, threads);
+        }
+
+        void *mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        auto error = errno;
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+            throw std::system_error(error, std::generic_category(), "mmap");
+        ::madvise(mapping, bytes, MADV_SEQUENTIAL);
+
+        try {
+            auto first = static_cast<const char *>(mapping);
+            auto result = parse_graph<V, W>(first, first + bytes, format, directed, weighted, threads);
+            ::munmap(mapping, bytes);
+            return result;
+        } catch (...) {
+            ::munmap(mapping, bytes);
+            throw;
+        }
+    }
+}
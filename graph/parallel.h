@@ -0,0 +1,111 @@
+#pragma once
+
+#ifndef GRAPH_PARALLEL_H
+#define GRAPH_PARALLEL_H
+
+#endif //GRAPH_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace graph {
+    inline size_t default_threads() {
+        size_t result = std::thread::hardware_concurrency();
+        return result ? result : 1;
+    }
+
+    // hands out [begin, end) in chunks of grain elements, f(thread, lo, hi) is called for every chunk.
+    // The first exception thrown by f stops handing out chunks and is rethrown once every thread has joined
+    template<typename F>
+    void parallel_for(size_t begin, size_t end, size_t threads, size_t grain, F f) {
+        if (begin >= end)
+            return;
+        if (!grain)
+            grain = 1;
+
+        size_t chunks = (end - begin + grain - 1) / grain;
+        threads = std::max<size_t>(1, std::min(threads, chunks));
+        if (threads == 1) {
+            f(size_t(0), begin, end);
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+        std::exception_ptr error;
+        std::mutex error_lock;
+        auto worker = [&](size_t thread) {
+            try {
+                for (size_t chunk = next.fetch_add(1, std::memory_order_relaxed); chunk < chunks;
+                     chunk = next.fetch_add(1, std::memory_order_relaxed)) {
+                    size_t lo = begin + chunk * grain;
+                    f(thread, lo, std::min(lo + grain, end));
+                }
+            } catch (...) {
+                next.store(chunks, std::memory_order_relaxed);
+                std::lock_guard<std::mutex> guard(error_lock);
+                if (!error)
+                    error = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (size_t i = 1; i < threads; ++i) {
+            try {
+                pool.emplace_back(worker, i);
+            } catch (const std::system_error &) {       // out of threads, the ones already running share the work
+                break;
+            }
+        }
+        worker(0);
+
+        for (auto &it : pool)
+            it.join();
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    // in-place inclusive prefix sum: blocks are scanned in parallel, their totals serially, then every block
+    // adds the total of the blocks before it
+    template<typename T>
+    void parallel_prefix_sum(std::vector<T> &values, size_t threads) {
+        constexpr size_t grain = size_t(1) << 16;
+
+        size_t n = values.size();
+        size_t blocks = std::max<size_t>(1, std::min(threads, n / grain));
+        auto block_range = [n, blocks](size_t block, size_t &lo, size_t &hi) {
+            lo = n * block / blocks;
+            hi = n * (block + 1) / blocks;
+        };
+
+        std::vector<T> carry(blocks + 1, T());
+        parallel_for(0, blocks, blocks, 1, [&](size_t, size_t lo_block, size_t hi_block) {
+            for (size_t block = lo_block; block < hi_block; ++block) {
+                size_t lo;
+                size_t hi;
+                block_range(block, lo, hi);
+                for (size_t i = lo + 1; i < hi; ++i)
+                    values[i] += values[i - 1];
+                if (lo < hi)
+                    carry[block + 1] = values[hi - 1];
+            }
+        });
+        for (size_t block = 1; block <= blocks; ++block)
+            carry[block] += carry[block - 1];
+
+        parallel_for(1, blocks, blocks, 1, [&](size_t, size_t lo_block, size_t hi_block) {
+            for (size_t block = lo_block; block < hi_block; ++block) {
+                size_t lo;
+                size_t hi;
+                block_range(block, lo, hi);
+                for (size_t i = lo; i < hi; ++i)
+                    values[i] += carry[block];
+            }
+        });
+    }
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#ifndef GRAPH_RANDOM_EDGES_H
+#define GRAPH_RANDOM_EDGES_H
+
+#endif //GRAPH_RANDOM_EDGES_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "parallel.h"
+
+namespace graph {
+    // index of (first, second), second < first, in the order (1, 0), (2, 0), (2, 1), (3, 0), ...
+    inline std::pair<size_t, size_t> unrank_unordered_pair(uint64_t index) {
+        auto first = static_cast<uint64_t>((1 + std::sqrt(1 + 8.0L * index)) / 2);
+        while (first * (first - 1) / 2 > index)
+            --first;
+        while ((first + 1) * first / 2 <= index)
+            ++first;
+
+        return {first, index - first * (first - 1) / 2};
+    }
+
+    // Floyd's sampling of count distinct indices out of [0, universe), sorted; O(count) memory, so it only trims
+    // the small surplus of gnm_edges
+    template<typename RNG>
+    std::vector<uint64_t> sample_distinct(uint64_t universe, uint64_t count, RNG &gen) {
+        std::unordered_set<uint64_t> chosen;
+        chosen.reserve(count);
+        for (uint64_t j = universe - count; j < universe; ++j) {
+            auto candidate = std::uniform_int_distribution<uint64_t>(0, j)(gen);
+            if (!chosen.insert(candidate).second)
+                chosen.insert(j);
+        }
+
+        std::vector<uint64_t> result(chosen.begin(), chosen.end());
+        std::sort(result.begin(), result.end());
+
+        return result;
+    }
+
+    inline uint64_t mix64(uint64_t value) {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+        return value ^ (value >> 31);
+    }
+
+    // splitmix64; every chunk of work draws from its own stream, so the output depends on the seed only,
+    // not on the thread count
+    class Stream_rng final {
+        uint64_t state;
+
+    public:
+        using result_type = uint64_t;
+
+        Stream_rng(uint64_t seed, uint64_t stream) : state(mix64(seed + (stream + 1) * 0x9E3779B97F4A7C15ull)) {};
+
+        static constexpr result_type min() {
+            return 0;
+        };
+
+        static constexpr result_type max() {
+            return std::numeric_limits<result_type>::max();
+        };
+
+        result_type operator()() {
+            return mix64(state += 0x9E3779B97F4A7C15ull);
+        };
+    };
+
+    struct Generated_edge {
+        size_t first;
+        size_t last;
+        size_t weight;
+    };
+
+    // generate(chunk, out) runs in parallel, sink(first, last, weight) sees the chunks in order;
+    // chunks are produced in waves so only a few of them are buffered at a time
+    template<typename Generate, typename Sink>
+    void emit_chunks(size_t chunks, size_t threads, Generate generate, Sink sink) {
+        size_t wave = std::max<size_t>(1, threads) * 4;
+        std::vector<std::vector<Generated_edge>> buffers(std::min(wave, chunks));
+
+        for (size_t first = 0; first < chunks; first += wave) {
+            size_t last = std::min(chunks, first + wave);
+            parallel_for(first, last, threads, 1, [&](size_t, size_t lo, size_t hi) {
+                for (size_t chunk = lo; chunk < hi; ++chunk) {
+                    buffers[chunk - first].clear();
+                    generate(chunk, buffers[chunk - first]);
+                }
+            });
+
+            for (size_t chunk = first; chunk < last; ++chunk)
+                for (const auto &it : buffers[chunk - first])
+                    sink(it.first, it.last, it.weight);
+        }
+    }
+
+    // Erdos-Renyi G(n, m): the pair space is swept with geometric skips at a probability slightly above m / pairs,
+    // then a uniform sample of the surplus is dropped to leave exactly m distinct edges
+    template<typename Sink>
+    void gnm_edges(size_t number_of_vertices, size_t number_of_edges, bool directed, uint64_t seed, Sink sink,
+                   size_t max_weight = 0, size_t threads = default_threads()) {
+        constexpr size_t chunk_edges = size_t(1) << 16;
+
+        if (number_of_vertices > (size_t(1) << 32))
+            throw std::invalid_argument("number of vertices");
+
+        uint64_t pairs = number_of_vertices < 2 ? 0 : static_cast<uint64_t>(number_of_vertices) * (number_of_vertices - 1);
+        if (!directed)
+            pairs /= 2;
+        if (static_cast<uint64_t>(number_of_edges) > pairs)
+            throw std::invalid_argument("cannot create graph with such number of edges");
+        if (!number_of_edges)
+            return;
+
+        auto m = static_cast<double>(number_of_edges);
+        double probability = std::min(1.0, (m + 4 * std::sqrt(m) + 16) / static_cast<double>(pairs));
+        uint64_t chunks = std::max<uint64_t>(1, std::min<uint64_t>(pairs, number_of_edges / chunk_edges));
+        uint64_t span = pairs / chunks + (pairs % chunks != 0);
+
+        auto decode = [&](uint64_t index, size_t &first, size_t &last) {
+            if (directed) {
+                first = index / (number_of_vertices - 1);
+                last = index % (number_of_vertices - 1);
+                if (last >= first)
+                    ++last;
+            } else {
+                auto ends = unrank_unordered_pair(index);
+                first = ends.second;
+                last = ends.first;
+            }
+        };
+
+        // replays the chunk's stream: visit(index, weight) for every sampled pair
+        auto sample = [&](uint64_t salt, uint64_t chunk, auto visit) {
+            Stream_rng gen(seed + salt, chunk);
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            std::uniform_int_distribution<size_t> weight_dis(1, max_weight ? max_weight : 1);
+            double log_complement = std::log1p(-probability);
+
+            uint64_t lo = std::min(pairs, chunk * span);
+            uint64_t hi = std::min(pairs, lo + span);
+            for (uint64_t index = lo; index < hi; ++index) {
+                if (probability < 1.0) {
+                    double skip = std::floor(std::log(1.0 - uniform(gen)) / log_complement);
+                    if (skip >= static_cast<double>(hi - index))
+                        break;
+                    index += static_cast<uint64_t>(skip);
+                }
+
+                visit(index, max_weight ? weight_dis(gen) : size_t(1));
+            }
+        };
+
+        std::vector<uint64_t> counts(chunks);
+        uint64_t salt = 0;
+        uint64_t total = 0;
+        for (;; ++salt) {
+            parallel_for(0, chunks, threads, 1, [&](size_t, size_t lo, size_t hi) {
+                for (size_t chunk = lo; chunk < hi; ++chunk) {
+                    uint64_t count = 0;
+                    sample(salt, chunk, [&count](uint64_t, size_t) {
+                        ++count;
+                    });
+                    counts[chunk] = count;
+                }
+            });
+
+            total = 0;
+            for (auto it : counts)
+                total += it;
+            if (total >= number_of_edges)       // falls short with negligible probability, resample then
+                break;
+        }
+
+        std::vector<uint64_t> offsets(chunks + 1, 0);
+        for (size_t i = 0; i < chunks; ++i)
+            offsets[i + 1] = offsets[i] + counts[i];
+
+        Stream_rng trim_gen(seed + salt, chunks);
+        auto dropped = sample_distinct(total, total - number_of_edges, trim_gen);
+
+        emit_chunks(chunks, threads, [&](size_t chunk, std::vector<Generated_edge> &out) {
+            auto position = offsets[chunk];
+            auto drop = std::lower_bound(dropped.begin(), dropped.end(), position);
+            sample(salt, chunk, [&](uint64_t index, size_t weight) {
+                if (drop != dropped.end() && *drop == position) {
+                    ++drop;
+                } else {
+                    Generated_edge edge{0, 0, weight};
+                    decode(index, edge.first, edge.last);
+                    out.push_back(edge);
+                }
+                ++position;
+            });
+        }, sink);
+    }
+}
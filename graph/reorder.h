@@ -0,0 +1,330 @@
+#pragma once
+
+#ifndef GRAPH_REORDER_H
+#define GRAPH_REORDER_H
+
+#endif //GRAPH_REORDER_H
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "CSR_graph.h"
+#include "parallel.h"
+
+namespace graph {
+    enum class Reorder_strategy {
+        degree,     // descending total degree, hubs first
+        rcm,        // reverse Cuthill-McKee, small bandwidth
+        gorder      // windowed Gorder approximation, neighbours and siblings close together
+    };
+
+    template<typename G>
+    struct Reordered_graph {
+        G graph;
+        std::vector<size_t> new_of_old;
+        std::vector<size_t> old_of_new;
+    };
+
+    template<typename V, typename W>
+    std::vector<size_t> total_degrees(const CSR_graph<V, W> &g) {
+        size_t n = g.number_of_verteces();
+        std::vector<size_t> result(n);
+        for (size_t i = 0; i < n; ++i)
+            result[i] = g.degree(i);
+        if (g.is_directed())
+            for (const auto &it : g.get_targets())
+                ++result[static_cast<size_t>(it)];
+
+        return result;
+    }
+
+    template<typename V, typename W>
+    std::vector<size_t> degree_order(const CSR_graph<V, W> &g) {       // old ids in their new order
+        auto degrees = total_degrees(g);
+        std::vector<size_t> result(g.number_of_verteces());
+        std::iota(result.begin(), result.end(), 0);
+        std::stable_sort(result.begin(), result.end(), [&degrees](size_t lhs, size_t rhs) {
+            return degrees[lhs] > degrees[rhs];
+        });
+
+        return result;
+    }
+
+    // Cuthill-McKee over the symmetrised graph: BFS from a pseudo-peripheral vertex of every component,
+    // neighbours in ascending degree, then the whole order reversed
+    template<typename V, typename W>
+    std::vector<size_t> rcm_order(const CSR_graph<V, W> &g) {
+        size_t n = g.number_of_verteces();
+        CSR_graph<V, W> reverse;
+        if (g.is_directed())
+            reverse = g.transpose();
+
+        auto degrees = total_degrees(g);
+        auto for_each_neighbour = [&](size_t vertex, auto f) {
+            for (auto it : g.adjacent(vertex))
+                f(static_cast<size_t>(it));
+            if (g.is_directed())
+                for (auto it : reverse.adjacent(vertex))
+                    f(static_cast<size_t>(it));
+        };
+
+        std::vector<size_t> result;
+        result.reserve(n);
+        std::vector<size_t> marks(n, 0);        // stamp of the last BFS that reached the vertex
+        size_t stamp = 0;
+        std::vector<size_t> queue;
+        std::vector<size_t> neighbours;
+
+        // BFS from start visiting neighbours by ascending degree, returns where the last level begins in order
+        auto sweep = [&](size_t start, std::vector<size_t> &order) {
+            ++stamp;
+            order.clear();
+            order.push_back(start);
+            marks[start] = stamp;
+
+            size_t last_level = 0;
+            for (size_t level_begin = 0, level_end = 1; level_begin < level_end; level_begin = level_end, level_end = order.size()) {
+                last_level = level_begin;
+                for (size_t head = level_begin; head < level_end; ++head) {
+                    neighbours.clear();
+                    for_each_neighbour(order[head], [&](size_t next) {
+                        if (marks[next] != stamp) {
+                            marks[next] = stamp;
+                            neighbours.push_back(next);
+                        }
+                    });
+                    std::sort(neighbours.begin(), neighbours.end(), [&degrees](size_t lhs, size_t rhs) {
+                        return degrees[lhs] < degrees[rhs] || (degrees[lhs] == degrees[rhs] && lhs < rhs);
+                    });
+                    order.insert(order.end(), neighbours.begin(), neighbours.end());
+                }
+            }
+
+            return last_level;
+        };
+
+        std::vector<size_t> by_degree(n);
+        std::iota(by_degree.begin(), by_degree.end(), 0);
+        std::stable_sort(by_degree.begin(), by_degree.end(), [&degrees](size_t lhs, size_t rhs) {
+            return degrees[lhs] < degrees[rhs];
+        });
+
+        std::vector<bool> placed(n, false);
+        for (auto root : by_degree) {
+            if (placed[root])
+                continue;
+
+            // two sweeps move the start towards the periphery of the component
+            auto start = root;
+            for (size_t attempt = 0; attempt < 2; ++attempt) {
+                auto first_of_last_level = sweep(start, queue);
+                auto candidate = *std::min_element(queue.begin() + first_of_last_level, queue.end(),
+                                                   [&degrees](size_t lhs, size_t rhs) {
+                                                       return degrees[lhs] < degrees[rhs];
+                                                   });
+                if (candidate == start)
+                    break;
+                start = candidate;
+            }
+
+            sweep(start, queue);
+            for (auto it : queue)
+                placed[it] = true;
+            result.insert(result.end(), queue.begin(), queue.end());
+        }
+
+        std::reverse(result.begin(), result.end());
+
+        return result;
+    }
+
+    // Gorder (Wei et al.) with a sliding window: the next vertex maximises the number of neighbours plus shared
+    // in-neighbours it has with the last window vertices. Scores live in a bucket queue with O(1) updates;
+    // siblings reached through hubs above sqrt(n) out-degree are ignored, as in the original heuristic
+    template<typename V, typename W>
+    std::vector<size_t> gorder_order(const CSR_graph<V, W> &g, size_t window = 5) {
+        size_t n = g.number_of_verteces();
+        if (!n)
+            return {};
+
+        CSR_graph<V, W> reverse;
+        if (g.is_directed())
+            reverse = g.transpose();
+        const auto &in_graph = g.is_directed() ? reverse : g;
+        auto hub_degree = static_cast<size_t>(std::sqrt(static_cast<double>(n))) + 1;
+
+        constexpr size_t none = static_cast<size_t>(-1);
+        std::vector<size_t> scores(n, 0);
+        std::vector<size_t> previous(n, none);
+        std::vector<size_t> next(n, none);
+        std::vector<size_t> heads(1, none);
+        std::vector<bool> placed(n, false);
+        size_t top = 0;
+
+        auto unlink = [&](size_t vertex) {
+            if (previous[vertex] != none)
+                next[previous[vertex]] = next[vertex];
+            else
+                heads[scores[vertex]] = next[vertex];
+            if (next[vertex] != none)
+                previous[next[vertex]] = previous[vertex];
+        };
+        auto push = [&](size_t vertex) {
+            if (heads.size() <= scores[vertex])
+                heads.resize(scores[vertex] + 1, none);
+
+            previous[vertex] = none;
+            next[vertex] = heads[scores[vertex]];
+            if (next[vertex] != none)
+                previous[next[vertex]] = vertex;
+            heads[scores[vertex]] = vertex;
+            top = std::max(top, scores[vertex]);
+        };
+        auto change = [&](size_t vertex, bool increase) {
+            if (placed[vertex])
+                return;
+
+            unlink(vertex);
+            scores[vertex] = increase ? scores[vertex] + 1 : scores[vertex] - 1;
+            push(vertex);
+        };
+        auto update = [&](size_t vertex, bool increase) {       // vertex enters or leaves the window
+            for (auto it : g.adjacent(vertex))
+                change(static_cast<size_t>(it), increase);
+            if (g.is_directed())
+                for (auto it : reverse.adjacent(vertex))
+                    change(static_cast<size_t>(it), increase);
+
+            for (auto parent : in_graph.adjacent(vertex)) {
+                auto source = static_cast<size_t>(parent);
+                if (g.degree(source) > hub_degree)
+                    continue;
+                for (auto sibling : g.adjacent(source))
+                    if (static_cast<size_t>(sibling) != vertex)
+                        change(static_cast<size_t>(sibling), increase);
+            }
+        };
+
+        for (size_t i = n; i-- > 0;)        // ties resolve to smaller ids
+            push(i);
+
+        size_t start = 0;
+        for (size_t i = 1; i < n; ++i)
+            if (in_graph.degree(i) > in_graph.degree(start))
+                start = i;
+
+        std::vector<size_t> result;
+        result.reserve(n);
+        for (size_t vertex = start; result.size() < n;) {
+            unlink(vertex);
+            placed[vertex] = true;
+            result.push_back(vertex);
+
+            update(vertex, true);
+            if (result.size() > window)
+                update(result[result.size() - window - 1], false);
+
+            while (top && heads[top] == none)
+                --top;
+            vertex = heads[top];
+            if (vertex == none)
+                break;
+        }
+
+        return result;
+    }
+
+    // relabels g so that old_of_new[i] becomes vertex i; lists are sorted by new id, weights travel with their edges
+    template<typename V, typename W>
+    CSR_graph<V, W> permute(const CSR_graph<V, W> &g, const std::vector<size_t> &old_of_new,
+                            size_t threads = default_threads()) {
+        size_t n = g.number_of_verteces();
+        if (old_of_new.size() != n)
+            throw std::invalid_argument("permutation");
+
+        std::vector<size_t> new_of_old(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            if (old_of_new[i] >= n || new_of_old[old_of_new[i]] != n)
+                throw std::invalid_argument("permutation");
+            new_of_old[old_of_new[i]] = i;
+        }
+
+        std::vector<size_t> offsets(n + 1, 0);
+        for (size_t i = 0; i < n; ++i)
+            offsets[i + 1] = offsets[i] + g.degree(old_of_new[i]);
+
+        std::vector<V> targets(offsets.back());
+        std::vector<W> weights(g.is_weighted() ? offsets.back() : 0);
+        parallel_for(0, n, threads, 1024, [&](size_t, size_t lo, size_t hi) {
+            std::vector<std::pair<V, W>> list;
+            for (size_t i = lo; i < hi; ++i) {
+                auto old = old_of_new[i];
+                auto neighbours = g.adjacent(old);
+                auto position = offsets[i];
+
+                if (!g.is_weighted()) {
+                    for (size_t j = 0, end_ = neighbours.size(); j < end_; ++j)
+                        targets[position + j] = static_cast<V>(new_of_old[static_cast<size_t>(neighbours[j])]);
+                    std::sort(targets.begin() + position, targets.begin() + position + neighbours.size());
+                    continue;
+                }
+
+                auto neighbour_weights = g.adjacent_weights(old);
+                list.clear();
+                for (size_t j = 0, end_ = neighbours.size(); j < end_; ++j)
+                    list.emplace_back(static_cast<V>(new_of_old[static_cast<size_t>(neighbours[j])]), neighbour_weights[j]);
+                std::sort(list.begin(), list.end(), [](const std::pair<V, W> &lhs, const std::pair<V, W> &rhs) {
+                    return lhs.first < rhs.first;
+                });
+                for (size_t j = 0, end_ = list.size(); j < end_; ++j) {
+                    targets[position + j] = list[j].first;
+                    weights[position + j] = list[j].second;
+                }
+            }
+        });
+
+        return CSR_graph<V, W>(g.is_directed(), std::move(offsets), std::move(targets), std::move(weights));
+    }
+
+    template<typename V, typename W>
+    Reordered_graph<CSR_graph<V, W>> reorder(const CSR_graph<V, W> &g, Reorder_strategy strategy,
+                                             size_t threads = default_threads()) {
+        Reordered_graph<CSR_graph<V, W>> result;
+        switch (strategy) {
+            case Reorder_strategy::degree:
+                result.old_of_new = degree_order(g);
+                break;
+            case Reorder_strategy::rcm:
+                result.old_of_new = rcm_order(g);
+                break;
+            case Reorder_strategy::gorder:
+                result.old_of_new = gorder_order(g);
+                break;
+        }
+
+        result.graph = permute(g, result.old_of_new, threads);
+        result.new_of_old.resize(result.old_of_new.size());
+        for (size_t i = 0, end_ = result.old_of_new.size(); i < end_; ++i)
+            result.new_of_old[result.old_of_new[i]] = i;
+
+        return result;
+    }
+
+    template<typename N>
+    Reordered_graph<DirectedGraph<N>> reorder(const DirectedGraph<N> &g, Reorder_strategy strategy,
+                                              size_t threads = default_threads()) {
+        auto frozen = reorder(freeze(g), strategy, threads);
+        return {to_directed_graph<N>(frozen.graph), std::move(frozen.new_of_old), std::move(frozen.old_of_new)};
+    }
+
+    template<typename N>
+    Reordered_graph<UndirectedGraph<N>> reorder(const UndirectedGraph<N> &g, Reorder_strategy strategy,
+                                                size_t threads = default_threads()) {
+        auto frozen = reorder(freeze(g), strategy, threads);
+        return {to_undirected_graph<N>(frozen.graph), std::move(frozen.new_of_old), std::move(frozen.old_of_new)};
+    }
+}
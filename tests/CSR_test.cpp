@@ -0,0 +1,155 @@
+// CSR_builder, freeze, transpose and the conversions back against per-vertex sorted lists of (target, weight),
+// on random multigraphs with loops and parallel edges
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../graph/CSR_graph.h"
+#include "check.h"
+
+using Csr = graph::CSR_graph<uint32_t, uint32_t>;
+using Lists = std::vector<std::vector<std::pair<size_t, uint32_t>>>;
+
+struct Edge {
+    size_t first;
+    size_t last;
+    uint32_t weight;
+};
+
+// an undirected edge shows up in the lists of both its ends, a loop twice in its own
+Lists expected_lists(size_t n, const std::vector<Edge> &edges, bool directed, bool weighted, bool reversed = false) {
+    Lists result(n);
+    for (const auto &it : edges) {
+        auto weight = weighted ? it.weight : 1;
+        if (reversed)
+            result[it.last].emplace_back(it.first, weight);
+        else
+            result[it.first].emplace_back(it.last, weight);
+        if (!directed)
+            result[it.last].emplace_back(it.first, weight);
+    }
+    for (auto &it : result)
+        std::sort(it.begin(), it.end());
+
+    return result;
+}
+
+Lists lists_of(const Csr &g) {
+    Lists result(g.number_of_verteces());
+    for (size_t v = 0; v < g.number_of_verteces(); ++v) {
+        auto targets = g.adjacent(v);
+        auto weights = g.adjacent_weights(v);
+        CHECK(targets.size() == g.degree(v));
+        CHECK(weights.size() == (g.is_weighted() ? targets.size() : 0));
+        for (size_t j = 0; j < targets.size(); ++j)
+            result[v].emplace_back(targets[j], g.is_weighted() ? weights[j] : 1);
+        std::sort(result[v].begin(), result[v].end());
+    }
+
+    return result;
+}
+
+template<typename G>
+Lists lists_of_graph(const G &g) {
+    Lists result(g.number_of_verteces());
+    for (size_t v = 0; v < g.number_of_verteces(); ++v) {
+        for (const auto &it : g.adjacent(v))
+            result[v].emplace_back(graph::edge_target(it), static_cast<uint32_t>(graph::edge_weight(it)));
+        std::sort(result[v].begin(), result[v].end());
+    }
+
+    return result;
+}
+
+std::vector<Edge> random_edges(size_t n, std::mt19937 &gen) {
+    std::vector<Edge> result(n ? gen() % (4 * n) : 0);
+    for (auto &it : result)
+        it = Edge{gen() % n, gen() % n, static_cast<uint32_t>(gen() % 100 + 1)};
+
+    return result;
+}
+
+void builder_and_transpose() {
+    std::mt19937 gen(39);
+    for (int round = 0; round < 400; ++round) {
+        size_t n = gen() % 60;
+        bool directed = gen() % 2;
+        bool weighted = gen() % 2;
+        auto edges = random_edges(n, gen);
+
+        graph::CSR_builder<uint32_t, uint32_t> builder(n, directed, weighted);
+        builder.reserve(edges.size());
+        for (const auto &it : edges)
+            builder.add_edge(it.first, it.last, it.weight);
+        CHECK_THROWS(std::invalid_argument, builder.add_edge(n, 0));
+        auto g = builder.build();
+
+        CHECK(g.number_of_verteces() == n && g.empty() == (n == 0));
+        CHECK(g.number_of_edges() == edges.size());
+        CHECK(g.is_directed() == directed && g.is_weighted() == (weighted && !edges.empty()));     // no weights to keep
+        CHECK(lists_of(g) == expected_lists(n, edges, directed, weighted));
+
+        auto reversed = g.transpose();
+        CHECK(reversed.number_of_edges() == g.number_of_edges() && reversed.is_directed() == directed);
+        CHECK(lists_of(reversed) == expected_lists(n, edges, directed, weighted, directed));
+        CHECK(lists_of(graph::transpose(reversed)) == lists_of(g));
+        CHECK(lists_of(graph::transpose(g)) == lists_of(reversed));
+
+        Csr copy(directed, std::vector<size_t>(g.get_offsets()), std::vector<uint32_t>(g.get_targets()),
+                 std::vector<uint32_t>(g.get_weights()));
+        CHECK(lists_of(copy) == lists_of(g));
+    }
+
+    CHECK(graph::CSR_builder<>(0, true, false).build().empty());
+    CHECK_THROWS(std::invalid_argument, Csr(true, std::vector<size_t>(), std::vector<uint32_t>()));
+    CHECK_THROWS(std::invalid_argument, Csr(true, std::vector<size_t>{0, 2}, std::vector<uint32_t>{0}));
+    CHECK_THROWS(std::invalid_argument, Csr(true, std::vector<size_t>{1, 1}, std::vector<uint32_t>{0}));
+    CHECK_THROWS(std::invalid_argument, Csr(true, std::vector<size_t>{0, 1}, std::vector<uint32_t>{0},
+                                            std::vector<uint32_t>{1, 2}));
+}
+
+// freeze keeps every list as it is, and the conversions back give the same lists again
+void freeze_and_back() {
+    std::mt19937 gen(390);
+    for (int round = 0; round < 400; ++round) {
+        size_t n = gen() % 60 + 1;
+        bool weighted = gen() % 2;
+        auto edges = random_edges(n, gen);
+
+        graph::DirectedGraph<graph::Node> directed(n, weighted);
+        graph::UndirectedGraph<graph::Node> undirected(n, weighted);
+        for (const auto &it : edges) {
+            graph::Node node[] = {weighted ? graph::Node(it.last, it.weight) : graph::Node(it.last)};
+            directed.add_node(it.first, node, 1);
+            undirected.add_node(it.first, node, 1);
+        }
+
+        auto frozen_directed = graph::freeze<uint32_t, uint32_t>(directed);
+        CHECK(frozen_directed.is_directed() && frozen_directed.number_of_edges() == edges.size());
+        CHECK(lists_of(frozen_directed) == expected_lists(n, edges, true, weighted));
+        CHECK(lists_of(frozen_directed) == lists_of_graph(directed));
+        CHECK(lists_of_graph(graph::to_directed_graph<graph::Node>(frozen_directed)) == lists_of_graph(directed));
+
+        auto frozen_undirected = graph::freeze<uint32_t, uint32_t>(undirected);
+        CHECK(!frozen_undirected.is_directed() && frozen_undirected.number_of_edges() == edges.size());
+        CHECK(lists_of(frozen_undirected) == expected_lists(n, edges, false, weighted));
+        CHECK(lists_of(frozen_undirected) == lists_of_graph(undirected));
+        CHECK(lists_of_graph(graph::to_undirected_graph<graph::Node>(frozen_undirected)) == lists_of_graph(undirected));
+        CHECK(lists_of(frozen_undirected.transpose()) == lists_of(frozen_undirected));
+
+        CHECK_THROWS(std::invalid_argument, graph::to_undirected_graph<graph::Node>(frozen_directed));
+    }
+}
+
+int main() {
+    builder_and_transpose();
+    freeze_and_back();
+    std::puts("CSR_test: ok");
+
+    return 0;
+}
@@ -0,0 +1,443 @@
+// every DSU variant against a union-find that relabels a whole set on every union
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../disjoint_set_union/DSU.h"
+#include "../disjoint_set_union/concurrent_DSU.h"
+#include "../disjoint_set_union/flat_DSU.h"
+#include "../disjoint_set_union/mapped_DSU.h"
+#include "../disjoint_set_union/rollback_DSU.h"
+#include "../disjoint_set_union/stream_connectivity.h"
+#include "check.h"
+
+class Naive_union_find final {
+    std::vector<size_t> labels;
+
+public:
+    explicit Naive_union_find(size_t sz) : labels(sz) {
+        std::iota(labels.begin(), labels.end(), size_t(0));
+    };
+    size_t add_element() {
+        labels.push_back(labels.size());
+        return labels.size() - 1;
+    };
+    bool unite(size_t lhs, size_t rhs) {
+        auto from = labels[rhs];
+        auto to = labels[lhs];
+        if (from == to)
+            return false;
+
+        std::replace(labels.begin(), labels.end(), from, to);
+        return true;
+    };
+    bool equivalent(size_t lhs, size_t rhs) const {
+        return labels[lhs] == labels[rhs];
+    };
+    size_t set_size(size_t element) const {
+        return static_cast<size_t>(std::count(labels.begin(), labels.end(), labels[element]));
+    };
+    size_t number_of_components() const {
+        return std::set<size_t>(labels.begin(), labels.end()).size();
+    };
+};
+
+void flat_DSU() {
+    std::mt19937 gen(32);
+    for (int round = 0; round < 100; ++round) {
+        size_t sz = gen() % 200 + 1;
+        Flat_DSU<> dsu(sz);
+        Flat_DSU<int> with_payload;
+        for (size_t i = 0; i < sz; ++i)
+            CHECK(with_payload.add_element(static_cast<int>(i) * 3) == i);
+        Naive_union_find reference(sz);
+
+        for (int step = 0; step < 400; ++step) {
+            auto lhs = static_cast<uint32_t>(gen() % sz);
+            auto rhs = static_cast<uint32_t>(gen() % sz);
+            if (gen() % 8 == 0) {
+                CHECK(dsu.add_element() == sz);
+                with_payload.add_element(static_cast<int>(sz) * 3);
+                reference.add_element();
+                ++sz;
+            }
+
+            if (gen() % 2) {
+                bool joined = !reference.equivalent(lhs, rhs);
+                auto root = dsu.unite(lhs, rhs);
+                CHECK(root == dsu.find(lhs) && root == dsu.find(rhs));
+                if (joined) {
+                    auto lroot = with_payload.find(lhs);
+                    auto rroot = with_payload.find(rhs);
+                    CHECK(with_payload.link(lroot, rroot) == with_payload.find(lhs));
+                }
+                reference.unite(lhs, rhs);
+            }
+            CHECK(dsu.equivalent(lhs, rhs) == reference.equivalent(lhs, rhs));
+            CHECK(with_payload.equivalent(lhs, rhs) == reference.equivalent(lhs, rhs));
+        }
+
+        CHECK(dsu.size() == sz);
+        for (uint32_t i = 0; i < sz; ++i)
+            CHECK(with_payload.data(i) == static_cast<int>(i) * 3);
+    }
+
+    Flat_DSU<> dsu(3);
+    CHECK_THROWS(std::invalid_argument, dsu.find(3));
+    CHECK_THROWS(std::invalid_argument, dsu.unite(0, 7));
+    CHECK_THROWS(std::length_error, Flat_DSU<>(size_t(Flat_DSU<>::max_size) + 1));
+    CHECK_THROWS(std::length_error, dsu.reserve(size_t(Flat_DSU<>::max_size) + 1));
+}
+
+// the same edges united from several threads at once give the partition of the serial reference
+void concurrent_DSU() {
+    std::mt19937 gen(33);
+    for (int round = 0; round < 20; ++round) {
+        size_t sz = gen() % 2000 + 1;
+        std::vector<std::pair<uint32_t, uint32_t>> edges(gen() % (2 * sz));
+        for (auto &it : edges)
+            it = std::make_pair(static_cast<uint32_t>(gen() % sz), static_cast<uint32_t>(gen() % sz));
+
+        Naive_union_find reference(sz);
+        size_t merges = 0;
+        for (const auto &it : edges)
+            merges += reference.unite(it.first, it.second);
+
+        for (size_t threads : {1, 2, 4}) {
+            Concurrent_DSU dsu(sz, static_cast<uint32_t>(gen()));
+            std::vector<size_t> successes(threads, 0);
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t]() {
+                    for (size_t i = t; i < edges.size(); i += threads)
+                        successes[t] += dsu.unite(edges[i].first, edges[i].second);
+                });
+            }
+            for (auto &it : workers)
+                it.join();
+
+            CHECK(std::accumulate(successes.begin(), successes.end(), size_t(0)) == merges);
+            for (int query = 0; query < 500; ++query) {
+                auto lhs = static_cast<uint32_t>(gen() % sz);
+                auto rhs = static_cast<uint32_t>(gen() % sz);
+                CHECK(dsu.same_set(lhs, rhs) == reference.equivalent(lhs, rhs));
+                CHECK((dsu.find(lhs) == dsu.find(rhs)) == reference.equivalent(lhs, rhs));
+            }
+        }
+    }
+
+    Concurrent_DSU dsu(3);
+    CHECK(dsu.size() == 3);
+    CHECK_THROWS(std::invalid_argument, dsu.find(3));
+    CHECK_THROWS(std::invalid_argument, dsu.unite(0, 3));
+    CHECK_THROWS(std::length_error, Concurrent_DSU(size_t(Concurrent_DSU::max_size) + 1));
+}
+
+// the pointer-based DSU with sum, min and max aggregates; members and aggregates are recomputed from the reference
+template <typename A>
+void pointer_DSU(unsigned seed) {
+    std::mt19937 gen(seed);
+    for (int round = 0; round < 50; ++round) {
+        DSU<long long, A> dsu;
+        std::vector<Node<long long, A> *> nodes;
+        std::vector<long long> values;
+        Naive_union_find reference(0);
+
+        for (int step = 0; step < 300; ++step) {
+            if (nodes.empty() || gen() % 4 == 0) {
+                values.push_back(static_cast<long long>(gen() % 2001) - 1000);
+                nodes.push_back(gen() % 2 ? dsu.add_element(values.back()) : dsu.add_element(static_cast<long long>(values.back())));
+                reference.add_element();
+            }
+
+            auto lhs = gen() % nodes.size();
+            auto rhs = gen() % nodes.size();
+            if (gen() % 2) {
+                dsu.unite(nodes[lhs], nodes[rhs]);
+                reference.unite(lhs, rhs);
+            }
+            CHECK(dsu.equivalent(nodes[lhs], nodes[rhs]) == reference.equivalent(lhs, rhs));
+            CHECK(dsu.number_of_components() == reference.number_of_components());
+            CHECK(dsu.set_size(nodes[lhs]) == reference.set_size(lhs));
+
+            std::vector<long long> members;
+            dsu.for_each_member(nodes[lhs], [&](const Node<long long, A> &member) {
+                members.push_back(member.data);
+            });
+            std::vector<long long> expected;
+            auto aggregate = values[lhs];
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                if (reference.equivalent(lhs, i)) {
+                    expected.push_back(values[i]);
+                    if (i != lhs)
+                        A::combine(aggregate, values[i]);
+                }
+            }
+            std::sort(members.begin(), members.end());
+            std::sort(expected.begin(), expected.end());
+            CHECK(members == expected);
+            CHECK(dsu.aggregate(nodes[lhs]) == aggregate);
+        }
+
+        auto moved = std::move(dsu);
+        CHECK(moved.number_of_components() == reference.number_of_components() && dsu.number_of_components() == 0);
+        dsu = std::move(moved);
+        CHECK(dsu.number_of_components() == reference.number_of_components());
+    }
+
+    DSU<long long, A> dsu;
+    auto element = dsu.add_element(1);
+    CHECK_THROWS(std::invalid_argument, dsu.unite(element, nullptr));
+    CHECK_THROWS(std::invalid_argument, dsu.equivalent(nullptr, element));
+    CHECK_THROWS(std::invalid_argument, dsu.set_size(nullptr));
+    CHECK_THROWS(std::invalid_argument, dsu.aggregate(nullptr));
+}
+
+// the partition survives closing and reopening the file; the file is removed afterwards
+void mapped_DSU() {
+    const std::string path = "DSU_test.mapped";
+    std::remove(path.c_str());
+
+    std::mt19937 gen(36);
+    size_t sz = 1500;       // crosses the first growth of the file
+    Naive_union_find reference(sz);
+    for (int reopen = 0; reopen < 5; ++reopen) {
+        Mapped_DSU dsu(path, reopen ? 0 : sz);
+        CHECK(dsu.size() == sz);
+        for (size_t i = 0; i < sz; ++i)
+            CHECK(dsu.equivalent(i, dsu.find(i)));
+
+        for (int step = 0; step < 2000; ++step) {
+            if (gen() % 16 == 0) {
+                CHECK(dsu.add_element() == sz);
+                reference.add_element();
+                ++sz;
+            }
+
+            auto lhs = gen() % sz;
+            auto rhs = gen() % sz;
+            if (gen() % 2) {
+                auto root = dsu.unite(lhs, rhs);
+                reference.unite(lhs, rhs);
+                CHECK(root == dsu.find(lhs) && root == dsu.find(rhs));
+            }
+            CHECK(dsu.equivalent(lhs, rhs) == reference.equivalent(lhs, rhs));
+        }
+
+        if (reopen % 2)
+            dsu.flatten();
+        dsu.flush();
+        CHECK_THROWS(std::invalid_argument, dsu.find(sz));
+    }
+
+    Mapped_DSU dsu(path);
+    for (size_t lhs = 0; lhs < sz; lhs += 7)
+        for (size_t rhs = 0; rhs < sz; rhs += 13)
+            CHECK(dsu.equivalent(lhs, rhs) == reference.equivalent(lhs, rhs));
+
+    auto moved = std::move(dsu);
+    CHECK(moved.size() == sz);
+    CHECK_THROWS(std::logic_error, dsu.reserve(1));
+    CHECK_THROWS(std::logic_error, dsu.find(0));
+    CHECK_THROWS(std::logic_error, dsu.flush());
+    dsu = std::move(moved);
+    CHECK(dsu.size() == sz);
+
+    {
+        std::ofstream corrupt(path, std::ios::binary | std::ios::trunc);
+        corrupt << "not a DSU";
+    }
+    CHECK_THROWS(std::runtime_error, Mapped_DSU{path});
+    std::remove(path.c_str());
+}
+
+// unions interleaved with rollbacks to earlier checkpoints; the reference is rebuilt from the surviving unions
+void rollback_DSU() {
+    std::mt19937 gen(34);
+    for (int round = 0; round < 100; ++round) {
+        size_t sz = gen() % 100 + 1;
+        Rollback_DSU dsu(sz);
+        std::vector<std::pair<uint32_t, uint32_t>> unions;      // successful ones, in the order of the history
+        std::vector<std::pair<size_t, size_t>> checkpoints;     // history length and number of unions at the time
+
+        for (int step = 0; step < 300; ++step) {
+            if (gen() % 5 == 0) {
+                checkpoints.emplace_back(dsu.checkpoint(), unions.size());
+            } else if (gen() % 6 == 0 && !checkpoints.empty()) {
+                auto index = gen() % checkpoints.size();
+                dsu.rollback(checkpoints[index].first);
+                unions.resize(checkpoints[index].second);
+                checkpoints.resize(index + 1);
+            } else {
+                auto lhs = static_cast<uint32_t>(gen() % sz);
+                auto rhs = static_cast<uint32_t>(gen() % sz);
+                bool joined = !dsu.equivalent(lhs, rhs);
+                CHECK(dsu.unite(lhs, rhs) == joined);
+                if (joined)
+                    unions.emplace_back(lhs, rhs);
+            }
+
+            Naive_union_find reference(sz);
+            for (const auto &it : unions)
+                CHECK(reference.unite(it.first, it.second));
+            CHECK(dsu.number_of_components() == reference.number_of_components());
+            for (int query = 0; query < 20; ++query) {
+                auto lhs = static_cast<uint32_t>(gen() % sz);
+                auto rhs = static_cast<uint32_t>(gen() % sz);
+                CHECK(dsu.equivalent(lhs, rhs) == reference.equivalent(lhs, rhs));
+            }
+        }
+    }
+
+    Rollback_DSU dsu(2);
+    CHECK_THROWS(std::invalid_argument, dsu.rollback(1));
+    CHECK_THROWS(std::invalid_argument, dsu.find(2));
+}
+
+// every answer equals connectivity recomputed from the multiset of live edges at the time of the query
+void offline_dynamic_connectivity() {
+    std::mt19937 gen(340);
+    for (int round = 0; round < 100; ++round) {
+        size_t sz = gen() % 30 + 1;
+        Offline_dynamic_connectivity solver(sz);
+        std::multiset<std::pair<uint32_t, uint32_t>> live;
+        std::vector<bool> expected;
+
+        for (int step = 0; step < 200; ++step) {
+            auto lhs = static_cast<uint32_t>(gen() % sz);
+            auto rhs = static_cast<uint32_t>(gen() % sz);
+            auto kind = gen() % 3;
+            if (kind == 0) {
+                solver.add_edge(lhs, rhs);
+                live.insert(std::minmax(lhs, rhs));
+            } else if (kind == 1 && !live.empty()) {
+                auto it = live.begin();
+                std::advance(it, gen() % live.size());
+                if (gen() % 2)
+                    solver.remove_edge(it->first, it->second);
+                else
+                    solver.remove_edge(it->second, it->first);
+                live.erase(it);
+            } else {
+                CHECK(solver.query(lhs, rhs) == expected.size());
+                Naive_union_find reference(sz);
+                for (const auto &it : live)
+                    reference.unite(it.first, it.second);
+                expected.push_back(reference.equivalent(lhs, rhs));
+            }
+        }
+
+        CHECK(solver.solve() == expected);
+    }
+
+    Offline_dynamic_connectivity solver(3);
+    CHECK_THROWS(std::invalid_argument, solver.add_edge(0, 3));
+    solver.remove_edge(0, 1);
+    CHECK_THROWS(std::invalid_argument, solver.solve());
+    CHECK(Offline_dynamic_connectivity(4).solve().empty());
+}
+
+// sparse 64-bit labels, edges fed one by one, as ranges and through consume; queries flush the pending batch
+void stream_connectivity() {
+    std::mt19937_64 gen(38);
+    for (size_t batch_size : {size_t(1), size_t(7), size_t(4096)}) {
+        for (int round = 0; round < 20; ++round) {
+            std::vector<uint64_t> pool(gen() % 300 + 2);
+            for (auto &it : pool)
+                it = gen();
+
+            Stream_connectivity<> stream(batch_size);
+            std::map<uint64_t, size_t> index;       // label to the element of the reference
+            Naive_union_find reference(0);
+            auto seen = [&](uint64_t label) {
+                if (index.emplace(label, index.size()).second)
+                    reference.add_element();
+                return index[label];
+            };
+
+            for (int step = 0; step < 600; ++step) {
+                auto first = pool[gen() % pool.size()];
+                auto second = pool[gen() % pool.size()];
+                switch (gen() % 8) {
+                    case 0:
+                        stream.add_vertex(first);
+                        seen(first);
+                        break;
+                    case 1: {
+                        std::vector<std::pair<uint64_t, uint64_t>> edges(gen() % 20);
+                        for (auto &it : edges) {
+                            it = std::make_pair(pool[gen() % pool.size()], pool[gen() % pool.size()]);
+                            reference.unite(seen(it.first), seen(it.second));
+                        }
+                        stream.add_edges(edges.begin(), edges.end());
+                        break;
+                    }
+                    case 2: {
+                        size_t left = gen() % 50;
+                        auto next = [&](uint64_t &lhs, uint64_t &rhs) {
+                            if (!left)
+                                return false;
+                            --left;
+                            lhs = pool[gen() % pool.size()];
+                            rhs = pool[gen() % pool.size()];
+                            reference.unite(seen(lhs), seen(rhs));
+                            return true;
+                        };
+                        auto expected = left;
+                        CHECK(stream.consume(next) == expected);
+                        break;
+                    }
+                    default:
+                        stream.add_edge(first, second);
+                        reference.unite(seen(first), seen(second));
+                        break;
+                }
+                CHECK(stream.number_of_vertices() == index.size());
+
+                if (gen() % 4 == 0) {
+                    CHECK(stream.number_of_components() == reference.number_of_components());
+
+                    auto lhs = pool[gen() % pool.size()];
+                    auto rhs = pool[gen() % pool.size()];
+                    bool known = index.count(lhs) && index.count(rhs);
+                    CHECK(stream.connected(lhs, rhs) == (lhs == rhs || (known && reference.equivalent(index[lhs], index[rhs]))));
+                    if (index.count(lhs))
+                        CHECK(stream.component_size(lhs) == reference.set_size(index[lhs]));
+                    else
+                        CHECK_THROWS(std::invalid_argument, stream.component_size(lhs));
+                }
+            }
+
+            stream.flush();
+            for (const auto &it : index)
+                CHECK(stream.component_size(it.first) == reference.set_size(it.second));
+        }
+    }
+}
+
+int main() {
+    flat_DSU();
+    concurrent_DSU();
+    pointer_DSU<Sum_aggregate<long long>>(35);
+    pointer_DSU<Min_aggregate<long long>>(350);
+    pointer_DSU<Max_aggregate<long long>>(351);
+    mapped_DSU();
+    rollback_DSU();
+    offline_dynamic_connectivity();
+    stream_connectivity();
+    std::puts("DSU_test: ok");
+
+    return 0;
+}
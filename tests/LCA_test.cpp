@@ -0,0 +1,142 @@
+// tarjan_lca against climbing parent links from the deeper vertex, on random forests with shuffled labels
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../graph/LCA.h"
+#include "check.h"
+
+using Queries = std::vector<std::pair<size_t, size_t>>;
+
+struct Forest {
+    std::vector<size_t> parent;     // graph::no_ancestor for the roots
+    std::vector<size_t> depth;
+};
+
+// the first roots labels in shuffled order are roots, every later vertex hangs off an earlier one
+Forest random_forest(size_t n, size_t roots, std::mt19937 &gen) {
+    std::vector<size_t> label(n);
+    std::iota(label.begin(), label.end(), size_t(0));
+    std::shuffle(label.begin(), label.end(), gen);
+
+    Forest result{std::vector<size_t>(n, graph::no_ancestor), std::vector<size_t>(n, 0)};
+    for (size_t i = roots; i < n; ++i) {
+        auto parent = label[gen() % i];
+        result.parent[label[i]] = parent;
+        result.depth[label[i]] = result.depth[parent] + 1;
+    }
+
+    return result;
+}
+
+size_t naive_lca(const Forest &forest, size_t lhs, size_t rhs) {
+    while (forest.depth[lhs] > forest.depth[rhs])
+        lhs = forest.parent[lhs];
+    while (forest.depth[rhs] > forest.depth[lhs])
+        rhs = forest.parent[rhs];
+    while (lhs != rhs) {
+        if (forest.parent[lhs] == graph::no_ancestor)
+            return graph::no_ancestor;
+        lhs = forest.parent[lhs];
+        rhs = forest.parent[rhs];
+    }
+
+    return lhs;
+}
+
+size_t root_of(const Forest &forest, size_t vertex) {
+    while (forest.parent[vertex] != graph::no_ancestor)
+        vertex = forest.parent[vertex];
+
+    return vertex;
+}
+
+template<typename G>
+void check_forest(const G &tree, const Forest &forest, size_t root, std::mt19937 &gen) {
+    auto n = forest.parent.size();
+    Queries queries(gen() % 200);
+    for (auto &it : queries)
+        it = std::make_pair(gen() % n, gen() % n);
+    if (n > 1)
+        queries.emplace_back(root, root);
+
+    auto answers = graph::tarjan_lca(tree, root, queries);
+    CHECK(answers.size() == queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto lhs = queries[i].first;
+        auto rhs = queries[i].second;
+        if (root_of(forest, lhs) != root || root_of(forest, rhs) != root)
+            CHECK(answers[i] == graph::no_ancestor);
+        else
+            CHECK(answers[i] == naive_lca(forest, lhs, rhs));
+    }
+}
+
+// edges go from parents to children
+void directed_trees() {
+    std::mt19937 gen(37);
+    for (int round = 0; round < 300; ++round) {
+        size_t n = gen() % 300 + 1;
+        auto forest = random_forest(n, std::min<size_t>(n, gen() % 3 + 1), gen);
+
+        graph::DirectedGraph<size_t> tree(n, false);
+        for (size_t v = 0; v < n; ++v) {
+            if (forest.parent[v] != graph::no_ancestor) {
+                size_t child[] = {v};
+                tree.add_node(forest.parent[v], child, 1);
+            }
+        }
+
+        for (size_t v = 0; v < n; ++v)
+            if (forest.parent[v] == graph::no_ancestor)
+                check_forest(tree, forest, v, gen);
+    }
+}
+
+// every edge is seen from both sides, so the traversal has to skip the parent
+void undirected_trees() {
+    std::mt19937 gen(370);
+    for (int round = 0; round < 300; ++round) {
+        size_t n = gen() % 300 + 1;
+        auto forest = random_forest(n, std::min<size_t>(n, gen() % 3 + 1), gen);
+
+        graph::UndirectedGraph<graph::Node> tree(n, false);
+        for (size_t v = 0; v < n; ++v) {
+            if (forest.parent[v] != graph::no_ancestor) {
+                graph::Node child[] = {graph::Node(v)};
+                tree.add_node(forest.parent[v], child, 1);
+            }
+        }
+
+        for (size_t v = 0; v < n; ++v)
+            if (forest.parent[v] == graph::no_ancestor)
+                check_forest(tree, forest, v, gen);
+    }
+
+    // a path deeper than any call stack would allow
+    size_t n = 1000000;
+    graph::UndirectedGraph<graph::Node> path(n, false);
+    for (size_t v = 0; v + 1 < n; ++v) {
+        graph::Node next[] = {graph::Node(v + 1)};
+        path.add_node(v, next, 1);
+    }
+    CHECK(graph::tarjan_lca(path, 0, Queries{{n - 1, n / 2}, {3, 0}}) == (std::vector<size_t>{n / 2, 0}));
+    CHECK(graph::tarjan_lca(path, n / 2, Queries{{0, n - 1}, {1, 2}}) == (std::vector<size_t>{n / 2, 2}));
+
+    CHECK_THROWS(std::invalid_argument, graph::tarjan_lca(path, n, Queries()));
+    CHECK_THROWS(std::invalid_argument, graph::tarjan_lca(path, 0, Queries{{0, n}}));
+}
+
+int main() {
+    directed_trees();
+    undirected_trees();
+    std::puts("LCA_test: ok");
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+// RMQ against a linear scan; ties resolve to the leftmost position, as std::min_element does
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../cartesian_tree/RMQ.h"
+#include "check.h"
+
+template <typename Compare>
+void check_all_queries(const std::vector<int>& values, const Compare& cmp) {
+    RMQ<int, Compare> rmq(values.data(), values.size(), cmp);
+    CHECK(rmq.size() == values.size());
+    for (size_t lo = 0; lo < values.size(); ++lo)
+        for (size_t hi = lo; hi < values.size(); ++hi)
+            CHECK(rmq.query(lo, hi) == static_cast<size_t>(std::min_element(values.begin() + lo, values.begin() + hi + 1, cmp) - values.begin()));
+}
+
+void exhaustive_small_arrays() {       // sizes around the 64-element blocks, few distinct values for many ties
+    std::mt19937 gen(31);
+    for (size_t sz : {1, 2, 63, 64, 65, 127, 128, 129, 300}) {
+        std::vector<int> values(sz);
+        for (auto& it : values)
+            it = static_cast<int>(gen() % 8);
+        check_all_queries(values, std::less<int>());
+        check_all_queries(values, std::greater<int>());
+    }
+
+    std::vector<int> ascending(200);
+    for (size_t i = 0; i < ascending.size(); ++i)
+        ascending[i] = static_cast<int>(i);
+    check_all_queries(ascending, std::less<int>());
+    check_all_queries(ascending, std::greater<int>());
+}
+
+void random_queries() {
+    std::mt19937 gen(310);
+    for (int round = 0; round < 50; ++round) {
+        std::vector<int> values(gen() % 20000 + 1);
+        for (auto& it : values)
+            it = static_cast<int>(gen() % 1000);
+
+        RMQ<int> rmq(values.data(), values.size());
+        for (int query = 0; query < 2000; ++query) {
+            size_t lo = gen() % values.size();
+            size_t hi = gen() % values.size();
+            if (lo > hi)
+                std::swap(lo, hi);
+            CHECK(rmq.query(lo, hi) == static_cast<size_t>(std::min_element(values.begin() + lo, values.begin() + hi + 1) - values.begin()));
+        }
+    }
+}
+
+void invalid_ranges() {
+    std::vector<int> values = {3, 1, 2};
+    RMQ<int> rmq(values.data(), values.size());
+    CHECK_THROWS(std::invalid_argument, rmq.query(2, 1));
+    CHECK_THROWS(std::invalid_argument, rmq.query(0, 3));
+    CHECK_THROWS(std::invalid_argument, RMQ<int>(nullptr, 3));
+
+    RMQ<int> empty(nullptr, 0);
+    CHECK(empty.size() == 0);
+    CHECK_THROWS(std::invalid_argument, empty.query(0, 0));
+}
+
+int main() {
+    exhaustive_small_arrays();
+    random_queries();
+    invalid_ranges();
+    std::puts("RMQ_test: ok");
+
+    return 0;
+}
@@ -0,0 +1,294 @@
+// Cartesian_tree against std::map, with the heap order, the key order and the predecessor links checked
+// after every change
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../cartesian_tree/cartesian_tree.h"
+#include "check.h"
+
+using Tree = Cartesian_tree<int, int>;
+using Reference = std::map<int, int>;
+using Elements = std::vector<std::pair<int, int>>;
+
+size_t check_subtree(const Node<int, int> *node, const Node<int, int> *predecessor, const int *lo, const int *hi) {
+    if (!node)
+        return 0;
+
+    CHECK(node->predecessor == predecessor);
+    CHECK(!lo || *lo < node->key);
+    CHECK(!hi || node->key < *hi);
+    CHECK(!predecessor || predecessor->priority <= node->priority);
+
+    return 1 + check_subtree(node->left, node, lo, &node->key) + check_subtree(node->right, node, &node->key, hi);
+}
+
+void check_tree(const Tree &tree) {
+    CHECK(check_subtree(tree.top, nullptr, nullptr, nullptr) == tree.size());
+
+    auto maximum = tree.top;
+    while (maximum && maximum->right)
+        maximum = maximum->right;
+    CHECK(tree.maximum == maximum);
+}
+
+Elements contents(const Tree &tree) {       // in order, without the iterators
+    Elements result;
+    std::vector<const Node<int, int> *> stack;
+    for (auto node = static_cast<const Node<int, int> *>(tree.top); node || !stack.empty();) {
+        for (; node; node = node->left)
+            stack.push_back(node);
+        node = stack.back();
+        stack.pop_back();
+        result.emplace_back(node->key, node->priority);
+        node = node->right;
+    }
+
+    return result;
+}
+
+void check_same(const Tree &tree, const Reference &reference) {
+    check_tree(tree);
+    CHECK(contents(tree) == Elements(reference.begin(), reference.end()));
+}
+
+// batches hold duplicates of each other and of the tree; the first copy of a key wins, as with map::emplace
+void sorted_batches() {
+    std::mt19937 gen(26);
+    for (int round = 0; round < 200; ++round) {
+        Tree tree;
+        Reference reference;
+        for (int batch = 0; batch < 6; ++batch) {
+            Elements elements(gen() % 80);
+            for (auto &it : elements)
+                it = std::make_pair(static_cast<int>(gen() % 150), static_cast<int>(gen() % 1000));
+            std::stable_sort(elements.begin(), elements.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.first < rhs.first;
+            });
+
+            tree = insert_batch(std::move(tree), elements.begin(), elements.end());
+            for (const auto &it : elements)
+                reference.emplace(it);
+            check_same(tree, reference);
+
+            std::pair<int, int> single(static_cast<int>(gen() % 150), static_cast<int>(gen() % 1000));
+            tree = insert(std::move(tree), single);
+            reference.emplace(single);
+            check_same(tree, reference);
+        }
+    }
+
+    Elements unsorted = {{2, 0}, {1, 0}};
+    CHECK_THROWS(std::invalid_argument, insert_batch(Tree(), unsorted.begin(), unsorted.end()));
+}
+
+// iterators, lookups, bounds, range scans and both erase overloads
+void scans_and_erase() {
+    std::mt19937 gen(27);
+    for (int round = 0; round < 200; ++round) {
+        Reference reference;
+        for (size_t i = 0, end_ = gen() % 200; i < end_; ++i)
+            reference.emplace(static_cast<int>(gen() % 300), static_cast<int>(gen() % 1000));
+        Elements elements(reference.begin(), reference.end());
+        Tree tree = insert_batch(Tree(), elements.begin(), elements.end());
+
+        for (int step = 0; step < 200; ++step) {
+            auto key = static_cast<int>(gen() % 320);
+            switch (gen() % 4) {
+                case 0:
+                    CHECK(tree.erase(key) == reference.erase(key));
+                    break;
+                case 1:
+                    tree = insert(std::move(tree), std::make_pair(key, static_cast<int>(gen() % 1000)));
+                    reference.emplace(key, tree.find(key)->priority);
+                    break;
+                case 2: {
+                    auto position = tree.find(key);
+                    if (position != tree.end()) {
+                        auto next = std::next(position);
+                        auto after = tree.erase(position);
+                        CHECK(after == next);
+                        reference.erase(key);
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+            check_same(tree, reference);
+
+            auto found = tree.find(key);
+            CHECK((found != tree.end()) == (reference.count(key) == 1));
+            CHECK(tree.find(tree.begin(), key) == found);
+            if (found != tree.end())
+                CHECK(tree.find(found, key) == found);
+
+            auto lower = tree.lower_bound(key);
+            auto reference_lower = reference.lower_bound(key);
+            CHECK((lower == tree.end()) == (reference_lower == reference.end()));
+            CHECK(lower == tree.end() || lower->key == reference_lower->first);
+
+            auto upper = tree.upper_bound(key);
+            auto reference_upper = reference.upper_bound(key);
+            CHECK((upper == tree.end()) == (reference_upper == reference.end()));
+            CHECK(upper == tree.end() || upper->key == reference_upper->first);
+
+            auto hi = key + static_cast<int>(gen() % 50);
+            auto scan = tree.range(key, hi);
+            Elements scanned;
+            for (auto it = scan.first; it != scan.second; ++it)
+                scanned.emplace_back(it->key, it->priority);
+            CHECK(scanned == Elements(reference.lower_bound(key), reference.lower_bound(hi)));
+        }
+
+        Elements forward;
+        for (const auto &it : tree)
+            forward.emplace_back(it.key, it.priority);
+        CHECK(forward == Elements(reference.begin(), reference.end()));
+
+        Elements backward;
+        for (auto it = tree.end(); it != tree.begin();) {
+            --it;
+            backward.emplace_back(it->key, it->priority);
+        }
+        CHECK(backward == Elements(reference.rbegin(), reference.rend()));
+
+        Tree copy(tree);
+        check_same(copy, reference);
+
+        for (auto it = tree.begin(); it != tree.end();)
+            it = tree.erase(it);
+        check_tree(tree);
+        CHECK(tree.empty());
+        check_same(copy, reference);
+    }
+}
+
+// insert from arbitrary fingers and append; keys that are already present are reported, not replaced
+void finger_insertion() {
+    std::mt19937 gen(28);
+    for (int round = 0; round < 200; ++round) {
+        Tree tree;
+        Reference reference;
+        for (int step = 0; step < 300; ++step) {
+            auto key = static_cast<int>(gen() % 400);
+            auto priority = static_cast<int>(gen() % 1000);
+            auto finger = tree.empty() || gen() % 2 ? tree.end() : tree.lower_bound(static_cast<int>(gen() % 400));
+
+            std::pair<Tree::iterator, bool> result;
+            if (gen() % 2)
+                result = tree.append(std::make_pair(key, priority));
+            else
+                result = tree.insert(finger, std::make_pair(key, priority));
+            CHECK(result.second == reference.emplace(key, priority).second);
+            CHECK(result.first->key == key && result.first->priority == reference[key]);
+            if (gen() % 4 == 0) {
+                auto erased = static_cast<int>(gen() % 400);
+                CHECK(tree.erase(erased) == reference.erase(erased));
+            }
+            check_same(tree, reference);
+        }
+    }
+
+    // ascending keys only ever climb the right spine
+    Tree tree;
+    Reference reference;
+    std::mt19937 gen_priority(5);
+    for (int key = 0; key < 100000; ++key) {
+        auto priority = static_cast<int>(gen_priority() % 100000);
+        CHECK(tree.append(std::make_pair(key, priority)).second);
+        reference.emplace(key, priority);
+    }
+    check_same(tree, reference);
+}
+
+// every answer of a batch equals the single lookup, across several lockstep groups
+void batched_lookups() {
+    std::mt19937 gen(29);
+    for (int round = 0; round < 100; ++round) {
+        Tree tree;
+        for (size_t i = 0, end_ = gen() % 300; i < end_; ++i)
+            tree.append(std::make_pair(static_cast<int>(i * 3), static_cast<int>(gen() % 1000)));
+
+        std::vector<int> keys(gen() % 100);
+        for (auto &it : keys)
+            it = static_cast<int>(gen() % 1000);
+        std::vector<Tree::iterator> found(keys.size() + 1);
+        auto last = tree.find_batch(keys.begin(), keys.end(), found.begin());
+        CHECK(last == found.begin() + static_cast<std::ptrdiff_t>(keys.size()));
+        for (size_t i = 0; i < keys.size(); ++i)
+            CHECK(found[i] == tree.find(keys[i]));
+    }
+}
+
+// the Eytzinger snapshot answers like the tree it was taken from, and does not follow later changes
+void frozen_snapshots() {
+    std::mt19937 gen(30);
+    for (int round = 0; round < 200; ++round) {
+        Reference reference;
+        for (size_t i = 0, end_ = gen() % 300; i < end_; ++i)
+            reference.emplace(static_cast<int>(gen() % 500), static_cast<int>(gen() % 1000));
+        Elements elements(reference.begin(), reference.end());
+        Tree tree = insert_batch(Tree(), elements.begin(), elements.end());
+        auto frozen = freeze(tree);
+        for (auto it = tree.begin(); it != tree.end();)
+            it = tree.erase(it);
+
+        CHECK(frozen.size() == reference.size() && frozen.empty() == reference.empty());
+        Elements forward;
+        for (const auto &it : frozen)
+            forward.emplace_back(it.key, it.priority);
+        CHECK(forward == elements);
+
+        Elements backward;
+        for (auto it = frozen.end(); it != frozen.begin();) {
+            --it;
+            backward.emplace_back(it->key, it->priority);
+        }
+        CHECK(backward == Elements(reference.rbegin(), reference.rend()));
+
+        for (int step = 0; step < 100; ++step) {
+            auto key = static_cast<int>(gen() % 520);
+
+            auto found = frozen.find(key);
+            CHECK((found != frozen.end()) == (reference.count(key) == 1));
+            CHECK(found == frozen.end() || found->priority == reference[key]);
+
+            auto lower = frozen.lower_bound(key);
+            auto reference_lower = reference.lower_bound(key);
+            CHECK((lower == frozen.end()) == (reference_lower == reference.end()));
+            CHECK(lower == frozen.end() || lower->key == reference_lower->first);
+
+            auto upper = frozen.upper_bound(key);
+            auto reference_upper = reference.upper_bound(key);
+            CHECK((upper == frozen.end()) == (reference_upper == reference.end()));
+            CHECK(upper == frozen.end() || upper->key == reference_upper->first);
+
+            auto hi = key + static_cast<int>(gen() % 60);
+            auto scan = frozen.range(key, hi);
+            Elements scanned;
+            for (auto it = scan.first; it != scan.second; ++it)
+                scanned.emplace_back(it->key, it->priority);
+            CHECK(scanned == Elements(reference.lower_bound(key), reference.lower_bound(hi)));
+        }
+    }
+
+    Frozen_cartesian_tree<int, int> empty;
+    CHECK(empty.empty() && empty.begin() == empty.end() && empty.find(1) == empty.end());
+}
+
+int main() {
+    sorted_batches();
+    scans_and_erase();
+    finger_insertion();
+    batched_lookups();
+    frozen_snapshots();
+    std::puts("cartesian_tree_test: ok");
+
+    return 0;
+}
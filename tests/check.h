@@ -0,0 +1,30 @@
+#pragma once
+
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#endif //TESTS_CHECK_H
+
+#include <cstdio>
+#include <cstdlib>
+
+// tests are plain programs: a failed check prints where it failed and exits with status 1
+#define CHECK(condition)                                                                \
+    do {                                                                                \
+        if (!(condition)) {                                                             \
+            std::fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, #condition); \
+            std::exit(1);                                                               \
+        }                                                                               \
+    } while (false)
+
+// expression must throw an exception of type E
+#define CHECK_THROWS(E, expression)                                                     \
+    do {                                                                                \
+        bool thrown_ = false;                                                           \
+        try {                                                                           \
+            expression;                                                                 \
+        } catch (const E &) {                                                           \
+            thrown_ = true;                                                             \
+        }                                                                               \
+        CHECK(thrown_ && #expression);                                                  \
+    } while (false)
@@ -0,0 +1,183 @@
+// Compressed_graph against the sorted lists of the CSR graph it was built from: iteration, blocks decoded on
+// their own, weights following their edges, and decompress
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../graph/compressed_graph.h"
+#include "../graph/generators.h"
+#include "check.h"
+
+using Csr = graph::CSR_graph<uint32_t, uint32_t>;
+using Compressed = graph::Compressed_graph<uint32_t>;
+using Lists = std::vector<std::vector<std::pair<size_t, size_t>>>;
+
+const size_t thread_counts[] = {1, 2, 4};
+
+// sorted by target; parallel edges keep no particular order, so their weights are sorted as well
+template<typename G>
+Lists sorted_lists(const G &g) {
+    Lists result(g.number_of_verteces());
+    for (size_t v = 0; v < result.size(); ++v) {
+        for (size_t j = 0; j < g.degree(v); ++j)
+            result[v].emplace_back(g.adjacent(v)[j], g.is_weighted() ? g.adjacent_weights(v)[j] : 0);
+        std::sort(result[v].begin(), result[v].end());
+    }
+
+    return result;
+}
+
+Lists lists_of(const Compressed &g) {
+    Lists result(g.number_of_verteces());
+    for (size_t v = 0; v < result.size(); ++v) {
+        size_t j = 0;
+        for (auto it : g.adjacent(v))
+            result[v].emplace_back(it, g.is_weighted() ? g.adjacent_weights(v)[j++] : 0);
+        CHECK(std::is_sorted(result[v].begin(), result[v].end(), [](const std::pair<size_t, size_t> &lhs,
+                                                                   const std::pair<size_t, size_t> &rhs) {
+            return lhs.first < rhs.first;
+        }));
+        std::sort(result[v].begin(), result[v].end());
+    }
+
+    return result;
+}
+
+// every block on its own gives the same neighbours at the same positions as a walk over the whole list
+void check_blocks(const Compressed &g) {
+    for (size_t v = 0; v < g.number_of_verteces(); ++v) {
+        std::vector<size_t> whole(g.adjacent(v).begin(), g.adjacent(v).end());
+        CHECK(whole.size() == g.degree(v) && g.adjacent(v).size() == g.degree(v));
+        CHECK(g.blocks(v) == (whole.size() + Compressed::block_size - 1) / Compressed::block_size);
+
+        std::vector<size_t> seen(whole.size(), std::numeric_limits<size_t>::max());
+        for (size_t block = g.blocks(v); block-- > 0;) {        // backwards, so no block leans on the one before
+            g.for_each_in_block(v, block, [&](size_t neighbour, size_t index) {
+                CHECK(index / Compressed::block_size == block);
+                seen[index] = neighbour;
+            });
+        }
+        CHECK(seen == whole);
+
+        size_t expected = 0;
+        g.for_each_neighbour(v, [&](size_t neighbour, size_t index) {
+            CHECK(index == expected && neighbour == whole[expected]);
+            ++expected;
+        });
+        CHECK(expected == whole.size());
+    }
+}
+
+void check_same(const Compressed &compressed, const Csr &g) {
+    CHECK(compressed.number_of_verteces() == g.number_of_verteces() && compressed.number_of_edges() == g.number_of_edges());
+    CHECK(compressed.is_directed() == g.is_directed() && compressed.is_weighted() == g.is_weighted());
+    CHECK(compressed.empty() == g.empty());
+    CHECK(lists_of(compressed) == sorted_lists(g));
+    check_blocks(compressed);
+
+    auto back = compressed.decompress<uint32_t>();
+    CHECK(sorted_lists(back) == sorted_lists(g));
+    CHECK(back.get_offsets() == g.get_offsets() && back.is_directed() == g.is_directed());
+}
+
+void varints() {
+    std::mt19937_64 gen(49);
+    std::vector<uint64_t> values = {0, 1, 0x7F, 0x80, 0x3FFF, 0x4000, std::numeric_limits<uint64_t>::max()};
+    for (int i = 0; i < 10000; ++i)
+        values.push_back(gen() >> (gen() % 64));
+
+    uint8_t buffer[16];
+    for (auto value : values) {
+        auto end = graph::encode_varint(value, buffer);
+        CHECK(static_cast<size_t>(end - buffer) == graph::varint_size(value));
+        uint64_t decoded;
+        CHECK(graph::decode_varint(buffer, decoded) == end && decoded == value);
+
+        auto signed_value = static_cast<int64_t>(value);
+        CHECK(graph::unzigzag(graph::zigzag(signed_value)) == signed_value);
+    }
+    CHECK(graph::zigzag(0) == 0 && graph::zigzag(-1) == 1 && graph::zigzag(1) == 2);
+    CHECK(graph::zigzag(std::numeric_limits<int64_t>::min()) == std::numeric_limits<uint64_t>::max());
+}
+
+std::vector<Csr> test_graphs() {
+    std::vector<Csr> result;
+    for (bool directed : {true, false}) {
+        result.push_back(graph::random_gnm_graph<uint32_t, uint32_t>(3000, 20000, directed, 49, 1000));
+        result.push_back(graph::random_gnm_graph<uint32_t, uint32_t>(100000, 200000, directed, 490));  // multi-byte gaps
+        result.push_back(graph::random_rmat_graph<uint32_t, uint32_t>(14, 150000, directed, 491, 0.57, 0.19, 0.19, 50));
+    }
+
+    // hubs of many blocks on both sides of their own id, duplicates and loops
+    std::mt19937 gen(492);
+    graph::CSR_builder<uint32_t, uint32_t> hubs(70000, true, true);
+    for (size_t hub : {size_t(0), size_t(35000), size_t(69999)})
+        for (size_t j = 0; j < 5000; ++j)
+            hubs.add_edge(hub, gen() % 70000, gen() % 100);
+    for (size_t j = 0; j < 200; ++j)
+        hubs.add_edge(5, 5, j);
+    for (size_t j = 0; j < 64; ++j)        // exactly one full block
+        hubs.add_edge(7, 1000 + j, j);
+    for (size_t j = 0; j < 65; ++j)        // one more than a block
+        hubs.add_edge(8, 60000 - j, j);
+    result.push_back(hubs.build());
+
+    result.push_back(graph::CSR_builder<uint32_t, uint32_t>(10, false, false).build());
+    result.push_back(Csr());
+
+    return result;
+}
+
+void round_trips() {
+    for (const auto &g : test_graphs()) {
+        Compressed expected(g, 1);
+        check_same(expected, g);
+        for (auto threads : thread_counts) {
+            Compressed other(g, threads);
+            CHECK(other.compressed_bytes() == expected.compressed_bytes());
+            CHECK(lists_of(other) == lists_of(expected));
+        }
+    }
+
+    // a sparse graph with ids close together takes fewer bytes than its 32-bit CSR arrays
+    graph::CSR_builder<uint32_t, uint32_t> ring(100000, true, false);
+    for (size_t v = 0; v < 100000; ++v)
+        for (size_t step : {1, 2, 3, 5, 8})
+            ring.add_edge(v, (v + step) % 100000);
+    auto ring_graph = ring.build();
+    Compressed compressed(ring_graph, 2);
+    check_same(compressed, ring_graph);
+    CHECK(compressed.compressed_bytes() < ring_graph.get_targets().size() * sizeof(uint32_t));
+}
+
+// several threads decode the blocks of one hub at the same time
+void parallel_blocks() {
+    graph::CSR_builder<uint32_t, uint32_t> star(200000, false, false);
+    for (size_t v = 1; v < 200000; ++v)
+        star.add_edge(0, v);
+    Compressed g(star.build(), 4);
+
+    std::vector<size_t> seen(g.degree(0), 0);
+    graph::parallel_for(0, g.blocks(0), 4, 16, [&](size_t, size_t lo, size_t hi) {
+        for (size_t block = lo; block < hi; ++block)
+            g.for_each_in_block(0, block, [&](size_t neighbour, size_t index) {
+                seen[index] = neighbour;
+            });
+    });
+    for (size_t j = 0; j < seen.size(); ++j)
+        CHECK(seen[j] == j + 1);
+}
+
+int main() {
+    varints();
+    round_trips();
+    parallel_blocks();
+    std::puts("compressed_graph_test: ok");
+
+    return 0;
+}
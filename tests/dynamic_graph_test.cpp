@@ -0,0 +1,216 @@
+// the twin-indexed graphs against sorted lists of (vertex, weight); parallel edges carry different weights, so
+// unlinking the wrong twin shows up as a wrong weight left behind
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../graph/dynamic_graph.h"
+#include "check.h"
+
+using Node = graph::Node;
+using Lists = std::vector<std::vector<std::pair<size_t, size_t>>>;
+
+void erase_one(std::vector<std::pair<size_t, size_t>> &list, std::pair<size_t, size_t> value) {
+    auto it = std::find(list.begin(), list.end(), value);
+    CHECK(it != list.end());
+    list.erase(it);
+}
+
+template<typename G>
+Lists lists_of(const G &g) {
+    Lists result(g.number_of_verteces());
+    for (size_t v = 0; v < result.size(); ++v) {
+        for (const auto &it : g.adjacent(v))
+            result[v].emplace_back(it.number, it.weight);
+        std::sort(result[v].begin(), result[v].end());
+    }
+
+    return result;
+}
+
+Lists lists_of(const graph::CSR_graph<> &g) {
+    Lists result(g.number_of_verteces());
+    for (size_t v = 0; v < result.size(); ++v) {
+        for (size_t j = 0; j < g.degree(v); ++j)
+            result[v].emplace_back(g.adjacent(v)[j], g.adjacent_weights(v)[j]);
+        std::sort(result[v].begin(), result[v].end());
+    }
+
+    return result;
+}
+
+Lists sorted(Lists lists) {
+    for (auto &it : lists)
+        std::sort(it.begin(), it.end());
+
+    return lists;
+}
+
+// a loop sits twice in the list of its vertex
+void undirected() {
+    std::mt19937 gen(44);
+    for (int round = 0; round < 300; ++round) {
+        size_t n = gen() % 20 + 1;
+        graph::DynamicUndirectedGraph<Node> g(n, true);
+        Lists reference(n);
+        size_t edges = 0;
+
+        for (int step = 0; step < 300; ++step) {
+            auto first = gen() % reference.size();
+            auto last = gen() % reference.size();
+            switch (gen() % 8) {
+                case 0: {
+                    Node list[] = {Node(first, gen() % 1000)};
+                    g.add_node(reference.size(), list, 1);
+                    reference.emplace_back(1, std::make_pair(first, list[0].weight));
+                    reference[first].emplace_back(reference.size() - 1, list[0].weight);
+                    ++edges;
+                    break;
+                }
+                case 1:
+                case 2:
+                    if (!reference[first].empty()) {
+                        auto index = gen() % reference[first].size();
+                        auto removed = g.adjacent(first)[index];
+                        g.remove_edge_at(first, index);
+                        erase_one(reference[first], std::make_pair(removed.number, removed.weight));
+                        erase_one(reference[removed.number], std::make_pair(first, removed.weight));
+                        --edges;
+                    }
+                    break;
+                case 3: {
+                    auto present = std::find_if(g.adjacent(first).begin(), g.adjacent(first).end(), [last](const Node &it) {
+                        return it.number == last;
+                    });
+                    if (present != g.adjacent(first).end()) {
+                        auto weight = present->weight;
+                        g.remove_edge(first, *present);
+                        erase_one(reference[first], std::make_pair(last, weight));
+                        erase_one(reference[last], std::make_pair(first, weight));
+                        --edges;
+                    }
+                    break;
+                }
+                case 4:
+                    g.remove_edge(first);
+                    while (!reference[first].empty()) {
+                        auto removed = reference[first].back();
+                        erase_one(reference[first], removed);
+                        erase_one(reference[removed.first], std::make_pair(first, removed.second));
+                        --edges;
+                    }
+                    break;
+                default: {
+                    Node list[] = {Node(last, gen() % 1000), Node(first, gen() % 1000)};
+                    g.add_node(first, list, 2);
+                    for (const auto &it : list) {
+                        reference[first].emplace_back(it.number, it.weight);
+                        reference[it.number].emplace_back(first, it.weight);
+                        ++edges;
+                    }
+                    break;
+                }
+            }
+
+            CHECK(lists_of(g) == sorted(reference));
+            CHECK(g.number_of_edges() == edges && g.number_of_verteces() == reference.size());
+            CHECK(g.degree(first) == reference[first].size());
+        }
+
+        CHECK(lists_of(graph::freeze(g)) == sorted(reference));
+        CHECK_THROWS(std::invalid_argument, g.remove_edge_at(0, g.degree(0)));
+        Node list[] = {Node(0, 1)};
+        CHECK_THROWS(std::invalid_argument, g.add_node(reference.size() + 1, list, 1));
+    }
+}
+
+// the incoming lists hold one source per edge
+void directed() {
+    std::mt19937 gen(440);
+    for (int round = 0; round < 300; ++round) {
+        size_t n = gen() % 20 + 1;
+        graph::DynamicDirectedGraph<Node> g(n, true);
+        Lists reference(n);
+        size_t edges = 0;
+
+        for (int step = 0; step < 300; ++step) {
+            auto first = gen() % reference.size();
+            auto last = gen() % reference.size();
+            switch (gen() % 8) {
+                case 0: {
+                    Node list[] = {Node(first, gen() % 1000)};
+                    g.add_node(reference.size(), list, 1);
+                    reference.emplace_back(1, std::make_pair(first, list[0].weight));
+                    ++edges;
+                    break;
+                }
+                case 1:
+                case 2:
+                    if (!reference[first].empty()) {
+                        auto index = gen() % reference[first].size();
+                        auto removed = g.adjacent(first)[index];
+                        g.remove_edge_at(first, index);
+                        erase_one(reference[first], std::make_pair(removed.number, removed.weight));
+                        --edges;
+                    }
+                    break;
+                case 3:
+                    g.remove_edge(first);
+                    edges -= reference[first].size();
+                    reference[first].clear();
+                    break;
+                case 4:
+                    g.isolate(first);
+                    for (auto &list : reference) {
+                        auto kept = std::remove_if(list.begin(), list.end(), [first](const std::pair<size_t, size_t> &it) {
+                            return it.first == first;
+                        });
+                        edges -= static_cast<size_t>(list.end() - kept);
+                        list.erase(kept, list.end());
+                    }
+                    edges -= reference[first].size();
+                    reference[first].clear();
+                    break;
+                default: {
+                    Node list[] = {Node(last, gen() % 1000)};
+                    g.add_node(first, list, 1);
+                    reference[first].emplace_back(last, list[0].weight);
+                    ++edges;
+                    break;
+                }
+            }
+
+            CHECK(lists_of(g) == sorted(reference));
+            CHECK(g.number_of_edges() == edges && g.number_of_verteces() == reference.size());
+
+            std::vector<std::vector<size_t>> sources(reference.size());
+            for (size_t v = 0; v < reference.size(); ++v)
+                for (const auto &it : reference[v])
+                    sources[it.first].push_back(v);
+            for (size_t v = 0; v < reference.size(); ++v) {
+                auto incoming = g.incoming(v);
+                std::sort(incoming.begin(), incoming.end());
+                std::sort(sources[v].begin(), sources[v].end());
+                CHECK(incoming == sources[v]);
+                CHECK(g.in_degree(v) == sources[v].size() && g.out_degree(v) == reference[v].size());
+            }
+        }
+
+        CHECK(lists_of(graph::freeze(g)) == sorted(reference));
+        CHECK_THROWS(std::invalid_argument, g.remove_edge_at(reference.size(), 0));
+        CHECK_THROWS(std::invalid_argument, g.incoming(reference.size()));
+    }
+}
+
+int main() {
+    undirected();
+    directed();
+    std::puts("dynamic_graph_test: ok");
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+// the generators give the same edges for the same seed at every thread count; G(n, m) gives exactly m distinct
+// edges without loops
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../graph/generators.h"
+#include "check.h"
+
+using Edges = std::vector<std::tuple<size_t, size_t, size_t>>;
+
+const size_t thread_counts[] = {1, 2, 4, 7};
+
+template<typename Generate>
+Edges collect(Generate generate) {
+    Edges result;
+    generate([&result](size_t first, size_t last, size_t weight) {
+        result.emplace_back(first, last, weight);
+    });
+
+    return result;
+}
+
+void pair_ranking() {
+    uint64_t index = 0;
+    for (size_t first = 1; first < 2000; ++first)
+        for (size_t second = 0; second < first; ++second)
+            CHECK(graph::unrank_unordered_pair(index++) == std::make_pair(first, second));
+
+    uint64_t big = 4000000000;      // near the largest vertex count, where a double square root is not exact
+    auto ends = graph::unrank_unordered_pair(big * (big - 1) / 2 + 5);
+    CHECK(ends.first == big && ends.second == 5);
+
+    std::mt19937_64 gen(45);
+    for (int round = 0; round < 100; ++round) {
+        uint64_t universe = gen() % 1000 + 1;
+        uint64_t count = gen() % (universe + 1);
+        auto sample = graph::sample_distinct(universe, count, gen);
+        CHECK(sample.size() == count && std::is_sorted(sample.begin(), sample.end()));
+        CHECK(std::adjacent_find(sample.begin(), sample.end()) == sample.end());
+        CHECK(sample.empty() || sample.back() < universe);
+    }
+}
+
+void gnm() {
+    struct Case {
+        size_t vertices;
+        size_t edges;
+        bool directed;
+        size_t max_weight;
+    };
+    const Case cases[] = {{2, 1, false, 0}, {50, 1225, false, 9}, {50, 2450, true, 0}, {1000, 5000, true, 100},
+                          {100000, 300000, false, 0}, {100000, 300000, true, 1000}, {10, 0, true, 0}};
+
+    for (const auto &it : cases) {
+        auto generate = [&it](uint64_t seed, size_t threads) {
+            return collect([&](auto sink) {
+                graph::gnm_edges(it.vertices, it.edges, it.directed, seed, sink, it.max_weight, threads);
+            });
+        };
+
+        auto expected = generate(45, 1);
+        CHECK(expected.size() == it.edges);
+        std::set<std::pair<size_t, size_t>> distinct;
+        for (const auto &edge : expected) {
+            size_t first, last, weight;
+            std::tie(first, last, weight) = edge;
+            CHECK(first < it.vertices && last < it.vertices && first != last);
+            CHECK(it.directed || first < last);
+            CHECK(weight >= 1 && weight <= std::max<size_t>(it.max_weight, 1));
+            distinct.emplace(first, last);
+        }
+        CHECK(distinct.size() == it.edges);
+
+        for (auto threads : thread_counts)
+            CHECK(generate(45, threads) == expected);
+        if (it.edges && it.edges < it.vertices * (it.vertices - 1) / (it.directed ? 1 : 2))      // not complete
+            CHECK(generate(46, 2) != expected);
+    }
+
+    auto sink = [](size_t, size_t, size_t) {};
+    CHECK_THROWS(std::invalid_argument, graph::gnm_edges(10, 46, false, 1, sink));
+    CHECK_THROWS(std::invalid_argument, graph::gnm_edges(10, 91, true, 1, sink));
+}
+
+void kronecker() {
+    for (size_t max_weight : {size_t(0), size_t(50)}) {
+        auto generate = [max_weight](size_t threads) {
+            return collect([&](auto sink) {
+                graph::rmat_edges(14, 200000, 451, sink, 0.57, 0.19, 0.19, max_weight, threads);
+            });
+        };
+
+        auto expected = generate(1);
+        CHECK(expected.size() == 200000);
+        for (const auto &edge : expected)
+            CHECK(std::get<0>(edge) < (1u << 14) && std::get<1>(edge) < (1u << 14));
+        for (auto threads : thread_counts)
+            CHECK(generate(threads) == expected);
+    }
+
+    auto three = collect([](auto sink) {
+        graph::kronecker_edges({0.4, 0.1, 0.1, 0.1, 0.1, 0.05, 0.05, 0.05, 0.05}, 5, 1000, 452, sink, 0, 3);
+    });
+    CHECK(three.size() == 1000);
+    for (const auto &edge : three)
+        CHECK(std::get<0>(edge) < 243 && std::get<1>(edge) < 243);
+
+    auto sink = [](size_t, size_t, size_t) {};
+    CHECK_THROWS(std::invalid_argument, graph::kronecker_edges({0.5, 0.5, 0.5}, 3, 10, 1, sink));
+    CHECK_THROWS(std::invalid_argument, graph::rmat_edges(3, 10, 1, sink, 0.6, 0.3, 0.3));
+}
+
+template<typename G>
+std::vector<std::vector<size_t>> lists_of(const G &g) {
+    std::vector<std::vector<size_t>> result(g.number_of_verteces());
+    for (size_t v = 0; v < result.size(); ++v)
+        for (const auto &it : g.adjacent(v))
+            result[v].push_back(static_cast<size_t>(it));
+
+    return result;
+}
+
+// the graph types built on top keep the lists in generation order, so they match exactly
+void graphs() {
+    auto csr = graph::random_gnm_graph<uint32_t, uint32_t>(20000, 150000, true, 453, 10, 1);
+    auto rmat = graph::random_rmat_graph<>(12, 100000, false, 454, 0.57, 0.19, 0.19, 0, 1);
+    auto directed = graph::random_directed_graph<graph::Node>(5000, 70000, 455, 7, 1);
+    auto undirected = graph::random_undirected_graph<graph::Node>(5000, 70000, 456, 1);
+    CHECK(csr.number_of_edges() == 150000 && directed.number_of_edges() == 70000);
+    CHECK(undirected.number_of_edges() == 70000);
+
+    for (auto threads : thread_counts) {
+        auto other = graph::random_gnm_graph<uint32_t, uint32_t>(20000, 150000, true, 453, 10, threads);
+        CHECK(other.get_offsets() == csr.get_offsets() && other.get_targets() == csr.get_targets());
+        CHECK(other.get_weights() == csr.get_weights());
+
+        auto other_rmat = graph::random_rmat_graph<>(12, 100000, false, 454, 0.57, 0.19, 0.19, 0, threads);
+        CHECK(other_rmat.get_offsets() == rmat.get_offsets() && other_rmat.get_targets() == rmat.get_targets());
+
+        CHECK(lists_of(graph::random_directed_graph<graph::Node>(5000, 70000, 455, 7, threads)) == lists_of(directed));
+        CHECK(lists_of(graph::random_undirected_graph<graph::Node>(5000, 70000, 456, threads)) == lists_of(undirected));
+    }
+
+    graph::DirectedGraph<graph::Node> member;
+    member.generate_random_graph(5000, 70000, 7, 455, 3);
+    CHECK(lists_of(member) == lists_of(directed));
+    CHECK(lists_of(graph::generate_random_directed_graph<graph::Node>(5000, 70000, 7, 455)) == lists_of(directed));
+    CHECK(lists_of(graph::generate_random_undirected_unweighted_graph<graph::Node>(5000, 70000, 456)) ==
+          lists_of(undirected));
+}
+
+int main() {
+    pair_ranking();
+    gnm();
+    kronecker();
+    graphs();
+    std::puts("generators_test: ok");
+
+    return 0;
+}
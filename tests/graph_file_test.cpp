@@ -0,0 +1,184 @@
+// write_graph and Mapped_graph round trips for several id and weight types, and rejection of damaged files:
+// flipped bytes, truncation, and headers forged with a matching checksum
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "../graph/generators.h"
+#include "../graph/graph_file.h"
+#include "check.h"
+
+const std::string path = "graph_file_test.graph";
+
+std::vector<char> read_file() {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void write_file(const std::vector<char> &bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+graph::Graph_file_header header_of(const std::vector<char> &bytes) {
+    graph::Graph_file_header result;
+    std::memcpy(&result, bytes.data(), sizeof(result));
+
+    return result;
+}
+
+// stores the header with a checksum that matches it, so only the other checks can catch it
+void forge(std::vector<char> &bytes, graph::Graph_file_header header) {
+    header.header_checksum = 0;
+    header.header_checksum = graph::checksum64(&header, sizeof(header));
+    std::memcpy(bytes.data(), &header, sizeof(header));
+}
+
+template<typename M, typename G>
+void check_same(const M &mapped, const G &g) {
+    CHECK(mapped.number_of_verteces() == g.number_of_verteces() && mapped.number_of_edges() == g.number_of_edges());
+    CHECK(mapped.is_directed() == g.is_directed() && mapped.is_weighted() == g.is_weighted());
+    CHECK(mapped.empty() == g.empty());
+    for (size_t v = 0; v < g.number_of_verteces(); ++v) {
+        CHECK(mapped.degree(v) == g.degree(v));
+        for (size_t j = 0; j < g.degree(v); ++j) {
+            CHECK(mapped.adjacent(v)[j] == g.adjacent(v)[j]);
+            if (g.is_weighted())
+                CHECK(mapped.adjacent_weights(v)[j] == g.adjacent_weights(v)[j]);
+        }
+        CHECK(mapped.adjacent_weights(v).size() == g.adjacent_weights(v).size());
+    }
+}
+
+template<typename V, typename W>
+void round_trip(const graph::CSR_graph<V, W> &g) {
+    graph::write_graph(g, path);
+    graph::Mapped_graph<V, W> mapped(path, true);
+    CHECK(mapped.verify());
+    check_same(mapped, g);
+
+    auto moved = std::move(mapped);
+    check_same(moved, g);
+    mapped = std::move(moved);
+    check_same(mapped, g);
+}
+
+void round_trips() {
+    std::mt19937 gen(46);
+    for (int round = 0; round < 40; ++round) {
+        size_t n = gen() % 500 + 1;
+        size_t m = gen() % (2 * n);
+        bool directed = gen() % 2;
+        auto max_weight = gen() % 2 ? 0 : gen() % 60000 + 1;
+        m = std::min(m, n * (n - 1) / 2);
+
+        round_trip(graph::random_gnm_graph<uint32_t, uint32_t>(n, m, directed, gen(), max_weight, 2));
+        round_trip(graph::random_gnm_graph<uint16_t, uint16_t>(n, m, directed, gen(), max_weight, 2));
+        round_trip(graph::random_gnm_graph<>(n, m, directed, gen(), max_weight, 2));
+    }
+
+    graph::CSR_builder<uint32_t, float> fractional(3, false, true);
+    fractional.add_edge(0, 1, 0.25f);
+    fractional.add_edge(2, 2, 1.5f);
+    round_trip(fractional.build());
+    round_trip(graph::CSR_graph<>());
+    round_trip(graph::CSR_builder<int32_t, int64_t>(1000, true, true).build());
+
+    graph::DirectedGraph<graph::Node> directed(3, true);
+    graph::Node list[] = {graph::Node(2, 9), graph::Node(1, 4)};
+    directed.add_node(0, list, 2);
+    graph::write_graph<uint32_t, uint64_t>(directed, path);
+    check_same(graph::Mapped_graph<uint32_t, uint64_t>(path), graph::freeze<uint32_t, uint64_t>(directed));
+}
+
+void corruption() {
+    auto g = graph::random_gnm_graph<uint32_t, uint32_t>(1000, 5000, true, 460, 100, 2);
+    graph::write_graph(g, path);
+    const auto good = read_file();
+    const auto header = header_of(good);
+    using Mapped = graph::Mapped_graph<uint32_t, uint32_t>;
+
+    // a flipped byte in any section fails the checksums; without verification only the ends of the offsets
+    // are looked at
+    for (uint64_t position : {header.offsets_position + 8 * 500, header.targets_position + 123,
+                              header.weights_position + 77, good.size() - 1}) {
+        auto bytes = good;
+        bytes[position] ^= 0x10;
+        write_file(bytes);
+        CHECK(!Mapped(path).verify());
+        CHECK_THROWS(std::runtime_error, Mapped(path, true));
+    }
+
+    auto damaged = good;
+    damaged[header.offsets_position + 8 * 1000] ^= 1;       // the end of the offsets
+    write_file(damaged);
+    CHECK_THROWS(std::runtime_error, Mapped{path});
+
+    damaged = good;
+    damaged[offsetof(graph::Graph_file_header, edges)] ^= 1;
+    write_file(damaged);
+    CHECK_THROWS(std::runtime_error, Mapped{path});
+
+    damaged = good;
+    damaged.pop_back();
+    write_file(damaged);
+    CHECK_THROWS(std::runtime_error, Mapped{path});
+
+    write_file(std::vector<char>(good.begin(), good.begin() + sizeof(graph::Graph_file_header) - 1));
+    CHECK_THROWS(std::runtime_error, Mapped{path});
+
+    auto forged = header;
+    forged.version = graph::graph_file_version + 1;
+    damaged = good;
+    forge(damaged, forged);
+    write_file(damaged);
+    CHECK_THROWS(std::runtime_error, Mapped{path});
+
+    // sizes picked so that unchecked products or sums would wrap around and look in range
+    std::vector<graph::Graph_file_header> overflowing(6, header);
+    overflowing[0].vertices = UINT64_MAX;
+    overflowing[1].vertices = UINT64_MAX / 8;
+    overflowing[2].entries = (UINT64_MAX / 4) + 1;
+    overflowing[3].offsets_position = 0;
+    overflowing[4].weights_position = UINT64_MAX - 63;
+    overflowing[5].targets_position = header.offsets_position + 64;
+    for (const auto &it : overflowing) {
+        damaged = good;
+        forge(damaged, it);
+        write_file(damaged);
+        CHECK_THROWS(std::runtime_error, Mapped{path});
+    }
+
+    forged = header;
+    forged.entries += 1;
+    damaged = good;
+    forge(damaged, forged);
+    write_file(damaged);
+    CHECK_THROWS(std::runtime_error, Mapped{path});
+
+    write_file(good);
+    CHECK(Mapped(path, true).verify());
+    CHECK_THROWS(std::invalid_argument, (graph::Mapped_graph<uint64_t, uint32_t>(path)));
+    CHECK_THROWS(std::invalid_argument, (graph::Mapped_graph<uint32_t, float>(path)));
+    std::remove(path.c_str());
+    CHECK_THROWS(std::system_error, Mapped{path});
+}
+
+int main() {
+    round_trips();
+    corruption();
+    std::remove(path.c_str());
+    std::puts("graph_file_test: ok");
+
+    return 0;
+}
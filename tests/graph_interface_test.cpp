@@ -0,0 +1,147 @@
+// the same edits through the concrete graph, through Graph_base and through Graph_adapter, against sorted
+// adjacency lists kept on the side
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../graph/CSR_graph.h"
+#include "../graph/graph.h"
+#include "check.h"
+
+using Node = graph::Node;
+using Directed = graph::DirectedGraph<Node>;
+using Undirected = graph::UndirectedGraph<Node>;
+using Lists = std::vector<std::vector<size_t>>;
+
+static_assert(graph::is_graph<Directed>::value && graph::is_graph<Undirected>::value, "graphs");
+static_assert(graph::is_graph<graph::CSR_graph<>>::value && !graph::is_graph<int>::value, "graph trait");
+static_assert(!std::is_polymorphic<Directed>::value && !std::is_polymorphic<Undirected>::value, "no vtable");
+static_assert(std::is_base_of<graph::Graph<Node>, graph::Graph_adapter<Directed>>::value, "adapter");
+
+template<typename G>
+Lists lists_of(const G &g) {
+    Lists result(g.number_of_verteces());
+    for (size_t v = 0; v < result.size(); ++v) {
+        for (const auto &it : g.adjacent(v))
+            result[v].push_back(graph::edge_target(it));
+        std::sort(result[v].begin(), result[v].end());
+    }
+
+    return result;
+}
+
+template<typename G>
+size_t edges_through_base(const graph::Graph_base<G, Node> &g) {
+    return g.number_of_edges();
+}
+
+void erase_one(std::vector<size_t> &list, size_t value) {
+    auto it = std::find(list.begin(), list.end(), value);
+    if (it != list.end())
+        list.erase(it);
+}
+
+// an undirected loop sits twice in the list of its vertex and counts as one edge
+template<typename G>
+void random_edits(bool directed, unsigned seed) {
+    std::mt19937 gen(seed);
+    for (int round = 0; round < 200; ++round) {
+        size_t n = gen() % 30 + 2;
+        G concrete(n, false);
+        G erased_target(n, false);
+        graph::Graph_adapter<G> adapter(erased_target);
+        graph::Graph<Node> &erased = adapter;
+        Lists reference(n);
+        size_t edges = 0;
+
+        for (int step = 0; step < 200; ++step) {
+            auto first = gen() % reference.size();
+            auto last = gen() % reference.size();
+            switch (gen() % 6) {
+                case 0: {
+                    size_t added = reference.size();
+                    Node list[] = {Node(first)};
+                    concrete.add_node(added, list, 1);
+                    erased.add_node(added, list, 1);
+                    reference.emplace_back(1, first);
+                    if (!directed)
+                        reference[first].push_back(added);
+                    ++edges;
+                    break;
+                }
+                case 1: {
+                    auto before = reference[first].size();
+                    concrete.remove_edge(first, Node(last));
+                    erased.remove_edge(first, Node(last));
+                    erase_one(reference[first], last);
+                    if (reference[first].size() != before) {
+                        if (!directed)
+                            erase_one(reference[last], first);
+                        --edges;
+                    }
+                    break;
+                }
+                case 2:
+                    concrete.remove_edge(first);
+                    erased.remove_edge(first);
+                    if (directed) {
+                        edges -= reference[first].size();
+                    } else {
+                        auto loops = static_cast<size_t>(std::count(reference[first].begin(), reference[first].end(), first));
+                        edges -= reference[first].size() - loops / 2;
+                        for (auto it : reference[first])
+                            if (it != first)
+                                erase_one(reference[it], first);
+                    }
+                    reference[first].clear();
+                    break;
+                default: {
+                    Node list[] = {Node(last)};
+                    concrete.add_node(first, list, 1);
+                    erased.add_node(first, list, 1);
+                    reference[first].push_back(last);
+                    if (!directed)
+                        reference[last].push_back(first);
+                    ++edges;
+                    break;
+                }
+            }
+            for (auto &it : reference)
+                std::sort(it.begin(), it.end());
+
+            CHECK(lists_of(concrete) == reference);
+            CHECK(lists_of(adapter.get()) == reference);
+            CHECK(concrete.number_of_edges() == edges && erased.number_of_edges() == edges);
+            CHECK(edges_through_base(concrete) == edges);
+            CHECK(concrete.number_of_verteces() == reference.size() && erased.number_of_verteces() == reference.size());
+            CHECK(!concrete.empty() && !erased.empty());
+            CHECK(!concrete.is_weighted() && !erased.is_weighted());
+        }
+
+        Node list[] = {Node(0)};
+        auto past = reference.size() + 1;
+        CHECK_THROWS(std::invalid_argument, concrete.add_node(past, list, 1));
+        CHECK_THROWS(std::invalid_argument, erased.add_node(past, list, 1));
+        CHECK_THROWS(std::invalid_argument, erased.remove_edge(past));
+        CHECK_THROWS(std::invalid_argument, concrete.remove_edge(0, Node(past)));
+    }
+
+    G empty;
+    graph::Graph_adapter<G> adapter(empty);
+    CHECK(empty.empty() && adapter.empty() && adapter.number_of_verteces() == 0);
+    adapter.reserve(10);
+    CHECK(empty.empty());
+}
+
+int main() {
+    random_edits<Directed>(true, 40);
+    random_edits<Undirected>(false, 400);
+    std::puts("graph_interface_test: ok");
+
+    return 0;
+}
@@ -0,0 +1,231 @@
+// parse_graph and read_graph against CSR_builder and freeze references at several thread counts: noisy edge lists,
+// adjacency lists as operator<< prints them, and general and symmetric Matrix Market files
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "../graph/graph_parser.h"
+#include "check.h"
+
+using Csr = graph::CSR_graph<uint32_t, uint32_t>;
+
+const size_t thread_counts[] = {1, 2, 4, 8};
+
+struct Edge {
+    size_t first;
+    size_t last;
+    uint32_t weight;
+};
+
+// the parser keeps neighbours in file order, so the arrays match the builder's exactly
+void check_same(const Csr &parsed, const Csr &expected) {
+    CHECK(parsed.is_directed() == expected.is_directed() && parsed.is_weighted() == expected.is_weighted());
+    CHECK(parsed.number_of_edges() == expected.number_of_edges());
+    CHECK(parsed.get_offsets() == expected.get_offsets());
+    CHECK(parsed.get_targets() == expected.get_targets());
+    CHECK(parsed.get_weights() == expected.get_weights());
+}
+
+Csr parse(const std::string &text, graph::Text_format format, bool directed, bool weighted, size_t threads) {
+    return graph::parse_graph<uint32_t, uint32_t>(text.data(), text.data() + text.size(), format, directed, weighted,
+                                                  threads);
+}
+
+Csr build(size_t n, const std::vector<Edge> &edges, bool directed, bool weighted) {
+    graph::CSR_builder<uint32_t, uint32_t> builder(n, directed, weighted);
+    for (const auto &it : edges)
+        builder.add_edge(it.first, it.last, it.weight);
+
+    return builder.build();
+}
+
+std::vector<Edge> random_edges(size_t n, size_t m, std::mt19937 &gen) {
+    std::vector<Edge> result(m);
+    for (auto &it : result)
+        it = Edge{gen() % n, gen() % n, static_cast<uint32_t>(gen() % 100000)};
+    result.push_back(Edge{n - 1, gen() % n, 1});     // the largest vertex is always mentioned
+
+    return result;
+}
+
+// blanks, tabs, carriage returns, plus signs, comments and empty lines between the edges
+std::string edge_list_text(const std::vector<Edge> &edges, bool with_weights, std::mt19937 &gen) {
+    const char *blanks[] = {" ", "\t", "  ", " \t "};
+    std::string result;
+    for (const auto &it : edges) {
+        switch (gen() % 8) {
+            case 0:
+                result += "# comment 1 2 3\n";
+                break;
+            case 1:
+                result += "\n";
+                break;
+            case 2:
+                result += "% another comment\r\n";
+                break;
+            default:
+                break;
+        }
+
+        result += blanks[gen() % 4];
+        result += (gen() % 8 ? "" : "+") + std::to_string(it.first) + blanks[gen() % 4] + std::to_string(it.last);
+        if (with_weights)
+            result += blanks[gen() % 4] + std::to_string(it.weight);
+        result += gen() % 2 ? "\n" : "\r\n";
+    }
+
+    return result;
+}
+
+void edge_lists() {
+    std::mt19937 gen(47);
+    for (int round = 0; round < 200; ++round) {
+        size_t n = gen() % 100 + 1;
+        auto edges = random_edges(n, gen() % 300, gen);
+        bool directed = gen() % 2;
+        bool weighted = gen() % 2;
+        bool with_weights = weighted || gen() % 2;      // weights in the file are dropped for unweighted graphs
+        auto text = edge_list_text(edges, with_weights, gen);
+        auto expected = build(n, edges, directed, weighted);
+
+        for (auto threads : thread_counts)
+            check_same(parse(text, graph::Text_format::edge_list, directed, weighted, threads), expected);
+    }
+
+    // several chunks and several owner blocks, without a trailing newline
+    auto edges = random_edges(50000, 400000, gen);
+    auto text = edge_list_text(edges, true, gen);
+    text.pop_back();
+    auto expected = build(50000, edges, false, true);
+    for (auto threads : thread_counts)
+        check_same(parse(text, graph::Text_format::edge_list, false, true, threads), expected);
+
+    CHECK(parse("", graph::Text_format::edge_list, true, false, 2).empty());
+    CHECK_THROWS(std::runtime_error, parse("1 2 x\n", graph::Text_format::edge_list, true, true, 1));
+    CHECK_THROWS(std::runtime_error, parse("1\n", graph::Text_format::edge_list, true, false, 1));
+    CHECK_THROWS(std::runtime_error, parse("-1 2\n", graph::Text_format::edge_list, true, false, 1));
+    CHECK_THROWS(std::length_error, (graph::parse_graph<uint16_t, uint32_t>("70000 1\n", "70000 1\n" + 8,
+                                                                           graph::Text_format::edge_list, true, false, 1)));
+}
+
+// what operator<< prints parses back to the same lists
+void adjacency_lists() {
+    std::mt19937 gen(470);
+    for (int round = 0; round < 100; ++round) {
+        size_t n = gen() % 200 + 1;
+        auto edges = random_edges(n, gen() % 600, gen);
+
+        graph::DirectedGraph<graph::Node> directed(n, true);
+        graph::UndirectedGraph<size_t> undirected(n, false);
+        for (const auto &it : edges) {
+            graph::Node node[] = {graph::Node(it.last, it.weight)};
+            directed.add_node(it.first, node, 1);
+            size_t plain[] = {it.last};
+            undirected.add_node(it.first, plain, 1);
+        }
+
+        std::ostringstream directed_text;
+        directed_text << directed;
+        std::ostringstream undirected_text;
+        undirected_text << undirected;
+
+        for (auto threads : thread_counts) {
+            check_same(parse(directed_text.str(), graph::Text_format::adjacency_list, true, true, threads),
+                       graph::freeze<uint32_t, uint32_t>(directed));
+            check_same(parse(undirected_text.str(), graph::Text_format::adjacency_list, false, false, threads),
+                       graph::freeze<uint32_t, uint32_t>(undirected));
+        }
+    }
+
+    CHECK_THROWS(std::runtime_error, parse("0: (1, 2\n", graph::Text_format::adjacency_list, true, true, 1));
+    CHECK_THROWS(std::runtime_error, parse("0 1 2\n", graph::Text_format::adjacency_list, true, false, 1));
+}
+
+// one-based coordinates; symmetric files are undirected, pattern files unweighted
+void matrix_market() {
+    std::mt19937 gen(471);
+    for (int round = 0; round < 100; ++round) {
+        size_t n = gen() % 100 + 1;
+        auto edges = random_edges(n, gen() % 300, gen);
+        bool directed = gen() % 2;
+        bool pattern = gen() % 2;
+
+        std::string text = std::string("%%MatrixMarket matrix coordinate ") + (pattern ? "pattern" : "integer") +
+                           (directed ? " general" : " symmetric") + "\n% comment\n\n";
+        size_t declared = n + gen() % 3;        // isolated vertices at the end are kept
+        text += std::to_string(declared) + " " + std::to_string(declared) + " " + std::to_string(edges.size()) + "\n";
+        for (const auto &it : edges) {
+            text += std::to_string(it.first + 1) + " " + std::to_string(it.last + 1);
+            if (!pattern)
+                text += " " + std::to_string(it.weight);
+            text += "\n";
+        }
+
+        auto expected = build(declared, edges, directed, !pattern);
+        for (auto threads : thread_counts) {
+            check_same(parse(text, graph::Text_format::matrix_market, true, true, threads), expected);
+            check_same(parse(text, graph::Text_format::matrix_market, false, false, threads),
+                       build(declared, edges, directed, false));
+        }
+    }
+
+    const std::string header = "%%MatrixMarket matrix coordinate pattern general\n3 3 1\n";
+    CHECK_THROWS(std::runtime_error, parse(header + "4 1\n", graph::Text_format::matrix_market, true, false, 1));
+    CHECK_THROWS(std::runtime_error, parse(header + "0 1\n", graph::Text_format::matrix_market, true, false, 1));
+    CHECK_THROWS(std::runtime_error, parse("%%MatrixMarket matrix array real general\n", graph::Text_format::matrix_market,
+                                           true, false, 1));
+    CHECK_THROWS(std::runtime_error, parse("%%MatrixMarket matrix coordinate complex general\n1 1 0\n",
+                                           graph::Text_format::matrix_market, true, false, 1));
+    CHECK_THROWS(std::runtime_error, parse("%%MatrixMarket matrix coordinate real general\n2 3 0\n",
+                                           graph::Text_format::matrix_market, true, false, 1));
+}
+
+void files() {
+    const std::string path = "graph_parser_test.txt";
+    std::mt19937 gen(472);
+    auto edges = random_edges(1000, 5000, gen);
+    auto text = edge_list_text(edges, true, gen);
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << text;
+    }
+    for (auto threads : thread_counts)
+        check_same(graph::read_graph<uint32_t, uint32_t>(path, graph::Text_format::edge_list, true, true, threads),
+                   build(1000, edges, true, true));
+
+    std::ofstream(path, std::ios::trunc).close();
+    CHECK((graph::read_graph<uint32_t, uint32_t>(path, graph::Text_format::edge_list, true, false, 2).empty()));
+    std::remove(path.c_str());
+    CHECK_THROWS(std::system_error, (graph::read_graph<uint32_t, uint32_t>(path, graph::Text_format::edge_list, true,
+                                                                          false, 2)));
+}
+
+void malformed_input_reaches_the_caller() {
+    std::string text;
+    for (size_t i = 0; i < 300000; ++i)        // several 1 MiB chunks, so several workers parse
+        text += std::to_string(i % 1000) + " " + std::to_string(i % 777) + "\n";
+    text += "12 x\n";
+
+    for (size_t threads : {1, 2, 4, 8})
+        CHECK_THROWS(std::runtime_error, (graph::parse_graph<uint32_t, uint32_t>(text.data(), text.data() + text.size(),
+                                                                                 graph::Text_format::edge_list, true,
+                                                                                 false, threads)));
+}
+
+int main() {
+    edge_lists();
+    adjacency_lists();
+    matrix_market();
+    files();
+    malformed_input_reaches_the_caller();
+    std::puts("graph_parser_test: ok");
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+// weights of compact and floating-point node types survive freeze, the traversal wrappers, reordering and
+// the undirected mirror halves
+
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+
+#include "../graph/BFS.h"
+#include "../graph/SSSP.h"
+#include "../graph/connected_components.h"
+#include "../graph/reorder.h"
+#include "check.h"
+
+using Float_node = graph::Basic_node<uint32_t, float>;
+
+void directed_float_weights() {
+    graph::DirectedGraph<Float_node> g(3, true);
+    Float_node first[] = {Float_node(1, 0.5f)};
+    Float_node second[] = {Float_node(2, 0.25f)};
+    g.add_node(0, first, 1);
+    g.add_node(1, second, 1);
+
+    auto frozen = graph::freeze(g);
+    static_assert(std::is_same<decltype(frozen), graph::CSR_graph<uint32_t, float>>::value, "node types are kept");
+
+    std::vector<double> expected = {0, 0.5, 0.75};
+    CHECK(graph::dijkstra(g, 0) == expected);
+    CHECK(graph::delta_stepping(g, 0, 0.25, 2) == expected);
+    CHECK(graph::delta_stepping(g, 0) == expected);
+
+    for (auto strategy : {graph::Reorder_strategy::degree, graph::Reorder_strategy::rcm, graph::Reorder_strategy::gorder}) {
+        auto reordered = graph::reorder(g, strategy, 2);
+        auto distances = graph::dijkstra(reordered.graph, reordered.new_of_old[0]);
+        for (size_t v = 0; v < 3; ++v)
+            CHECK(distances[reordered.new_of_old[v]] == expected[v]);
+    }
+}
+
+void undirected_float_weights() {
+    graph::CSR_builder<uint32_t, float> builder(3, false, true);
+    builder.add_edge(0, 1, 2.5f);
+    builder.add_edge(1, 2, 4.0f);
+    builder.add_edge(2, 2, 1.5f);
+    auto csr = builder.build();
+
+    auto g = graph::to_undirected_graph<Float_node>(csr);
+    for (size_t v = 0; v < 3; ++v) {
+        CHECK(g.adjacent(v).size() == csr.degree(v));
+        for (const auto &it : g.adjacent(v)) {
+            auto targets = csr.adjacent(v);
+            auto weights = csr.adjacent_weights(v);
+            bool found = false;
+            for (size_t j = 0; j < targets.size(); ++j)
+                found = found || (targets[j] == it.number && weights[j] == it.weight);
+            CHECK(found);
+        }
+    }
+
+    std::vector<double> expected = {0, 2.5, 6.5};
+    CHECK(graph::dijkstra(g, 0) == expected);
+    CHECK(graph::dijkstra(g, 2) == (std::vector<double>{6.5, 4, 0}));
+
+    auto reordered = graph::reorder(g, graph::Reorder_strategy::rcm, 2);
+    auto distances = graph::dijkstra(reordered.graph, reordered.new_of_old[0]);
+    for (size_t v = 0; v < 3; ++v)
+        CHECK(distances[reordered.new_of_old[v]] == expected[v]);
+
+    CHECK(graph::connected_components(g, 2).components == 1);
+    CHECK(graph::bfs(g, 0, 2).levels == (std::vector<size_t>{0, 1, 2}));
+}
+
+void compact_integer_weights() {
+    using Node = graph::Packed_node<uint32_t, uint16_t>;
+
+    graph::UndirectedGraph<Node> g(4, true);
+    Node list[] = {Node(1, 300), Node(2, 7)};
+    g.add_node(0, list, 2);
+    Node last[] = {Node(3, 1000)};
+    g.add_node(2, last, 1);
+
+    auto frozen = graph::freeze(g);
+    static_assert(std::is_same<decltype(frozen), graph::CSR_graph<uint32_t, uint16_t>>::value, "node types are kept");
+    CHECK(graph::dijkstra(g, 3) == (std::vector<uint64_t>{1007, 1307, 1000, 0}));
+}
+
+void fractional_weights() {
+    graph::CSR_builder<uint32_t, float> builder(64, true, true);
+    for (uint32_t v = 0; v + 1 < 64; ++v) {
+        builder.add_edge(v, v + 1, 0.001f * static_cast<float>(v % 7 + 1));
+        builder.add_edge(v, (v * 5 + 3) % 64, 0.004f);
+    }
+    auto csr = builder.build();
+
+    CHECK(graph::tune_delta(csr) < 0.01);
+    auto expected = graph::dijkstra(csr, 0);
+    for (size_t threads : {1, 3})
+        CHECK(graph::delta_stepping(csr, 0, 0, threads) == expected);
+}
+
+int main() {
+    directed_float_weights();
+    undirected_float_weights();
+    compact_integer_weights();
+    fractional_weights();
+    std::puts("node_types_test: ok");
+
+    return 0;
+}
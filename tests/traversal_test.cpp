@@ -0,0 +1,224 @@
+// the parallel traversals against serial references at several thread counts, on uniform and skewed graphs,
+// in memory and mapped from a graph file
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../graph/BFS.h"
+#include "../graph/SSSP.h"
+#include "../graph/connected_components.h"
+#include "../graph/generators.h"
+#include "../graph/graph_file.h"
+#include "check.h"
+
+using Csr = graph::CSR_graph<uint32_t, uint32_t>;
+
+const size_t thread_counts[] = {1, 2, 4};
+
+template<typename G>
+std::vector<size_t> serial_levels(const G &g, size_t source) {
+    std::vector<size_t> result(g.number_of_verteces(), graph::unreached);
+    std::deque<size_t> queue(1, source);
+    result[source] = 0;
+    while (!queue.empty()) {
+        auto vertex = queue.front();
+        queue.pop_front();
+        for (auto it : g.adjacent(vertex)) {
+            if (result[it] == graph::unreached) {
+                result[it] = result[vertex] + 1;
+                queue.push_back(it);
+            }
+        }
+    }
+
+    return result;
+}
+
+bool has_edge(const Csr &g, size_t first, size_t last) {
+    for (auto it : g.adjacent(first))
+        if (it == last)
+            return true;
+
+    return false;
+}
+
+// levels must match exactly; any parent one level up with an edge to the vertex is fine
+void check_bfs(const Csr &g, const graph::BFS_result &result, const std::vector<size_t> &levels, size_t source) {
+    CHECK(result.levels == levels);
+    CHECK(result.parents.size() == levels.size());
+    for (size_t v = 0; v < levels.size(); ++v) {
+        auto parent = result.parents[v];
+        if (levels[v] == graph::unreached)
+            CHECK(parent == graph::unreached);
+        else if (v == source)
+            CHECK(parent == source);
+        else
+            CHECK(parent < levels.size() && levels[parent] + 1 == levels[v] && has_edge(g, parent, v));
+    }
+}
+
+std::vector<Csr> bfs_graphs() {
+    std::vector<Csr> result;
+    for (bool directed : {true, false}) {
+        result.push_back(graph::random_gnm_graph<uint32_t, uint32_t>(5000, 4000, directed, 41));      // many small pieces
+        result.push_back(graph::random_gnm_graph<uint32_t, uint32_t>(3000, 60000, directed, 42));     // goes bottom-up
+        result.push_back(graph::random_rmat_graph<uint32_t, uint32_t>(13, 80000, directed, 43));
+    }
+
+    graph::CSR_builder<uint32_t, uint32_t> path(20000, false, false);      // thousands of tiny frontiers
+    for (size_t v = 0; v + 1 < 20000; ++v)
+        path.add_edge(v, v + 1);
+    result.push_back(path.build());
+    result.push_back(graph::CSR_builder<uint32_t, uint32_t>(1, true, false).build());
+
+    return result;
+}
+
+void bfs() {
+    auto graphs = bfs_graphs();
+    for (const auto &g : graphs) {
+        for (size_t source : {size_t(0), g.number_of_verteces() / 2, g.number_of_verteces() - 1}) {
+            auto levels = serial_levels(g, source);
+            for (auto threads : thread_counts)
+                check_bfs(g, graph::bfs(g, source, threads), levels, source);
+        }
+    }
+
+    const std::string path = "traversal_test.graph";
+    graph::write_graph(graphs[2], path);
+    {
+        graph::Mapped_graph<uint32_t, uint32_t> mapped(path, true);
+        auto levels = serial_levels(graphs[2], 7);
+        for (auto threads : thread_counts)
+            check_bfs(graphs[2], graph::bfs(mapped, 7, threads), levels, 7);
+    }
+    std::remove(path.c_str());
+
+    graph::DirectedGraph<graph::Node> small(3, false);
+    graph::Node list[] = {graph::Node(1), graph::Node(2)};
+    small.add_node(0, list, 2);
+    CHECK(graph::bfs(small, 1, 2).levels == (std::vector<size_t>{graph::unreached, 0, graph::unreached}));
+    CHECK(graph::bfs(small, 0, 2).parents == (std::vector<size_t>{0, 0, 0}));
+    CHECK_THROWS(std::invalid_argument, graph::bfs(graphs[0], graphs[0].number_of_verteces(), 2));
+    CHECK_THROWS(std::invalid_argument, graph::bfs(graphs[0], graphs[1], 0, 2));
+}
+
+// relaxes every edge until nothing changes
+std::vector<uint64_t> bellman_ford(const Csr &g, size_t source) {
+    std::vector<uint64_t> result(g.number_of_verteces(), graph::infinite_distance<uint32_t>());
+    result[source] = 0;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t v = 0; v < g.number_of_verteces(); ++v) {
+            if (result[v] == graph::infinite_distance<uint32_t>())
+                continue;
+            for (size_t j = 0; j < g.degree(v); ++j) {
+                auto next = g.adjacent(v)[j];
+                auto distance = result[v] + graph::csr_weight(g, v, j);
+                if (distance < result[next]) {
+                    result[next] = distance;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+void delta_stepping() {
+    std::vector<Csr> graphs;
+    for (bool directed : {true, false}) {
+        graphs.push_back(graph::random_gnm_graph<uint32_t, uint32_t>(300, 1500, directed, 42, 1000));
+        graphs.push_back(graph::random_gnm_graph<uint32_t, uint32_t>(4000, 40000, directed, 420, 50));
+        graphs.push_back(graph::random_rmat_graph<uint32_t, uint32_t>(12, 50000, directed, 421, 0.57, 0.19, 0.19, 100000));
+        graphs.push_back(graph::random_gnm_graph<uint32_t, uint32_t>(2000, 6000, directed, 422));     // unweighted
+    }
+
+    for (const auto &g : graphs) {
+        for (size_t source : {size_t(0), g.number_of_verteces() - 1}) {
+            auto expected = graph::dijkstra(g, source);
+            if (g.number_of_verteces() <= 300)
+                CHECK(expected == bellman_ford(g, source));
+
+            auto heaviest = static_cast<uint64_t>(graph::max_edge_weight(g));
+            for (uint64_t delta : {uint64_t(0), uint64_t(1), uint64_t(7), heaviest, 4 * heaviest})
+                for (auto threads : thread_counts)
+                    CHECK(graph::delta_stepping(g, source, delta, threads) == expected);
+        }
+    }
+
+    graph::CSR_builder<uint32_t, uint64_t> heavy(2, true, true);      // more buckets than the cyclic array allows
+    heavy.add_edge(0, 1, uint64_t(1) << 40);
+    auto heavy_graph = heavy.build();
+    CHECK(graph::delta_stepping(heavy_graph, 0, 0, 2) == graph::dijkstra(heavy_graph, 0));
+    CHECK_THROWS(std::invalid_argument, graph::delta_stepping(heavy_graph, 0, 1, 2));
+    CHECK_THROWS(std::invalid_argument, graph::delta_stepping(graphs[0], graphs[0].number_of_verteces(), 0, 2));
+}
+
+// every vertex is labelled with the smallest vertex of its component, the order a serial sweep finds them in
+std::vector<size_t> serial_components(const Csr &g) {
+    std::vector<size_t> result(g.number_of_verteces(), graph::unreached);
+    for (size_t v = 0; v < result.size(); ++v) {
+        if (result[v] != graph::unreached)
+            continue;
+
+        auto levels = serial_levels(g, v);
+        for (size_t i = v; i < result.size(); ++i)
+            if (levels[i] != graph::unreached)
+                result[i] = v;
+    }
+
+    return result;
+}
+
+void connected_components() {
+    std::vector<Csr> graphs;
+    graphs.push_back(graph::random_gnm_graph<uint32_t, uint32_t>(3000, 1200, false, 43));        // mostly isolated
+    graphs.push_back(graph::random_gnm_graph<uint32_t, uint32_t>(3000, 2000, false, 430));       // near the threshold
+    graphs.push_back(graph::random_gnm_graph<uint32_t, uint32_t>(3000, 30000, false, 431));      // one giant
+    graphs.push_back(graph::random_rmat_graph<uint32_t, uint32_t>(12, 20000, false, 432));
+
+    graph::CSR_builder<uint32_t, uint32_t> halves(4000, false, false);     // two equal giants, interleaved labels
+    for (size_t v = 0; v + 2 < 4000; ++v)
+        halves.add_edge(v, v + 2);
+    graphs.push_back(halves.build());
+
+    graph::CSR_builder<uint32_t, uint32_t> descending(5000, false, false);     // links always point at larger vertices
+    for (size_t v = 4999; v > 0; --v)
+        descending.add_edge(v, v - 1);
+    graphs.push_back(descending.build());
+    graphs.push_back(graph::CSR_builder<uint32_t, uint32_t>(0, false, false).build());
+
+    for (const auto &g : graphs) {
+        auto expected = serial_components(g);
+        size_t components = 0;
+        for (size_t v = 0; v < expected.size(); ++v)
+            components += expected[v] == v;
+
+        for (auto threads : thread_counts) {
+            auto result = graph::connected_components(g, threads);
+            CHECK(result.labels == expected);
+            CHECK(result.components == components);
+        }
+    }
+
+    auto undirected = graph::random_undirected_graph<graph::Node>(500, 400, 433);
+    auto frozen = graph::freeze<uint32_t, uint32_t>(undirected);
+    CHECK(graph::connected_components(undirected, 2).labels == serial_components(frozen));
+    CHECK_THROWS(std::invalid_argument, graph::connected_components(graph::random_gnm_graph<>(10, 10, true, 434), 2));
+}
+
+int main() {
+    bfs();
+    delta_stepping();
+    connected_components();
+    std::puts("traversal_test: ok");
+
+    return 0;
+}